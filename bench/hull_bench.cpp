@@ -0,0 +1,369 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cg/common/constants.h>
+#include <cg/convex_hull/graham.h>
+#include <cg/convex_hull/andrew.h>
+#include <cg/convex_hull/jarvis.h>
+#include <cg/convex_hull/quick_hull.h>
+#include <cg/convex_hull/parallel_hull.h>
+#include <cg/convex_hull/convex_hull_3.h>
+#include <cg/operations/diameter.h>
+#include <cg/operations/parallel_simplify.h>
+
+// cg-bench [max_n [output.json]]
+//
+// times the hull algorithms and diameter on n = 10^3 .. max_n points of several
+// distributions, the parallel algorithms on 1 .. 64 threads and the 3d hull, results
+// are written as json (to stdout if no output is given). inputs are generated from a
+// fixed seed, so runs are comparable
+
+using cg::point_2;
+
+typedef std::vector<point_2> points_t;
+typedef std::mt19937_64 random_t;
+
+namespace
+{
+   points_t uniform_square(size_t n, random_t & random)
+   {
+      std::uniform_real_distribution<double> d(-100., 100.);
+      points_t res(n);
+
+      for (point_2 & p : res)
+      {
+         p.x = d(random);
+         p.y = d(random);
+      }
+
+      return res;
+   }
+
+   points_t uniform_disk(size_t n, random_t & random)
+   {
+      std::uniform_real_distribution<double> d(-100., 100.);
+      points_t res;
+      res.reserve(n);
+
+      while (res.size() != n)
+      {
+         point_2 p(d(random), d(random));
+
+         if (p.x * p.x + p.y * p.y <= 100. * 100.)
+         {
+            res.push_back(p);
+         }
+      }
+
+      return res;
+   }
+
+   // every point is a hull vertex
+   points_t circle(size_t n, random_t & random)
+   {
+      std::uniform_real_distribution<double> d(0., 2 * cg::pi);
+      points_t res(n);
+
+      for (point_2 & p : res)
+      {
+         double a = d(random);
+         p = point_2(100. * cos(a), 100. * sin(a));
+      }
+
+      return res;
+   }
+
+   points_t gaussian_clusters(size_t n, random_t & random)
+   {
+      std::uniform_real_distribution<double> center(-100., 100.);
+      std::normal_distribution<double> d(0., 5.);
+
+      std::vector<point_2> centers(16);
+
+      for (point_2 & c : centers)
+      {
+         c = point_2(center(random), center(random));
+      }
+
+      points_t res(n);
+
+      for (size_t i = 0; i != n; ++i)
+      {
+         point_2 const & c = centers[i % centers.size()];
+         res[i] = point_2(c.x + d(random), c.y + d(random));
+      }
+
+      return res;
+   }
+
+   // small integer grid: duplicates and long runs of collinear points on the hull
+   points_t integer_grid(size_t n, random_t & random)
+   {
+      int side = std::max(2, int(std::sqrt(double(n)) / 4));
+      std::uniform_int_distribution<int> d(0, side);
+      points_t res(n);
+
+      for (point_2 & p : res)
+      {
+         p = point_2(d(random), d(random));
+      }
+
+      return res;
+   }
+
+   typedef std::vector<cg::point_3> points_3_t;
+
+   points_3_t uniform_cube(size_t n, random_t & random)
+   {
+      std::uniform_real_distribution<double> d(-100., 100.);
+      points_3_t res(n);
+
+      for (cg::point_3 & p : res)
+      {
+         p = cg::point_3(d(random), d(random), d(random));
+      }
+
+      return res;
+   }
+
+   // every point is a hull vertex
+   points_3_t sphere(size_t n, random_t & random)
+   {
+      points_3_t res = uniform_cube(n, random);
+
+      for (cg::point_3 & p : res)
+      {
+         double r = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+         p = cg::point_3(100. * p.x / r, 100. * p.y / r, 100. * p.z / r);
+      }
+
+      return res;
+   }
+
+   struct distribution
+   {
+      std::string name;
+      std::function<points_t (size_t, random_t &)> generate;
+      // a constant fraction of the points is on the hull, output sensitive algorithms
+      // are quadratic
+      bool large_hull;
+   };
+
+   struct algorithm
+   {
+      std::string name;
+      // returns the size of the result
+      std::function<size_t (points_t &)> run;
+      // O(nh), not run on distributions with large hulls beyond the smallest n
+      bool output_sensitive;
+   };
+
+   // polylines of 1000 vertices one after another, each is a random walk
+   points_t random_walks(size_t n, random_t & random)
+   {
+      std::normal_distribution<double> d(0., 1.);
+      points_t res(n);
+
+      for (size_t i = 0; i != n; ++i)
+      {
+         point_2 const & prev = (i % 1000) ? res[i - 1] : point_2(0, 0);
+         res[i] = point_2(prev.x + d(random), prev.y + d(random));
+      }
+
+      return res;
+   }
+
+   struct parallel_algorithm
+   {
+      std::string name;
+      distribution input;
+      // returns the size of the result
+      std::function<size_t (points_t &, size_t threads)> run;
+   };
+
+   template <class Hull>
+   std::function<size_t (points_t &)> hull_runner(Hull hull)
+   {
+      return [hull] (points_t & pts)
+      {
+         return size_t(hull(pts.begin(), pts.end()) - pts.begin());
+      };
+   }
+
+   struct result
+   {
+      std::string algorithm, distribution;
+      size_t n, threads, repeats, output;
+      double seconds;
+   };
+
+   // best of repeats runs, every run gets the same unpermuted input
+   template <class Points, class Run>
+   void measure(result & r, Points const & input, Run run)
+   {
+      Points pts;
+
+      for (size_t k = 0; k != r.repeats; ++k)
+      {
+         pts = input;
+
+         auto start = std::chrono::steady_clock::now();
+         r.output = run(pts);
+         std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+         r.seconds = k ? std::min(r.seconds, time.count()) : time.count();
+      }
+   }
+
+   void write_json(std::ostream & out, std::vector<result> const & results)
+   {
+      out.precision(9);
+      out << "{\n   \"benchmarks\": [";
+
+      for (size_t i = 0; i != results.size(); ++i)
+      {
+         result const & r = results[i];
+
+         out << (i ? "," : "") << "\n      {"
+             << "\"algorithm\": \"" << r.algorithm << "\", "
+             << "\"distribution\": \"" << r.distribution << "\", "
+             << "\"n\": " << r.n << ", "
+             << "\"threads\": " << r.threads << ", "
+             << "\"repeats\": " << r.repeats << ", "
+             << "\"seconds\": " << r.seconds << ", "
+             << "\"output\": " << r.output << "}";
+      }
+
+      out << "\n   ]\n}\n";
+   }
+}
+
+int main(int argc, char ** argv)
+{
+   size_t max_n = (argc > 1) ? std::strtoull(argv[1], NULL, 10) : 10000000;
+
+   std::vector<distribution> distributions =
+   {
+      {"uniform_square",    uniform_square,    false},
+      {"uniform_disk",      uniform_disk,      false},
+      {"circle",            circle,            true},
+      {"gaussian_clusters", gaussian_clusters, false},
+      {"integer_grid",      integer_grid,      true},
+   };
+
+   typedef points_t::iterator iter;
+
+   std::vector<algorithm> algorithms =
+   {
+      {"graham_hull", hull_runner([] (iter p, iter q) { return cg::graham_hull(p, q); }), false},
+      {"andrew_hull", hull_runner([] (iter p, iter q) { return cg::andrew_hull(p, q); }), false},
+      {"jarvis_hull", hull_runner([] (iter p, iter q) { return cg::jarvis_hull(p, q); }), true},
+      {"quick_hull",  hull_runner([] (iter p, iter q) { return cg::quick_hull(p, q); }),  false},
+      {"diameter",    [] (points_t & pts)
+                      {
+                         auto d = cg::diameter(pts.begin(), pts.end());
+                         return size_t(d.first != d.second ? 2 : 1);
+                      }, false},
+   };
+
+   std::vector<result> results;
+
+   for (distribution const & d : distributions)
+   {
+      for (size_t n = 1000; n <= max_n; n *= 10)
+      {
+         random_t random(n);
+         points_t const input = d.generate(n, random);
+         size_t repeats = (n <= 1000000) ? 5 : 1;
+
+         for (algorithm const & a : algorithms)
+         {
+            if (a.output_sensitive && d.large_hull && n > 1000)
+            {
+               continue;
+            }
+
+            result r = {a.name, d.name, n, 1, repeats, 0, 0};
+            measure(r, input, a.run);
+
+            std::cerr << d.name << ", " << a.name << ", n = " << n << ": " << r.seconds << " s" << std::endl;
+            results.push_back(r);
+         }
+      }
+   }
+
+   std::vector<parallel_algorithm> parallel_algorithms =
+   {
+      {"parallel_hull", distributions.front(), [] (points_t & pts, size_t threads)
+                                               {
+                                                  return size_t(cg::parallel_hull(pts.begin(), pts.end(), threads) - pts.begin());
+                                               }},
+      {"simplify_polylines", {"random_walks", random_walks, false}, [] (points_t & pts, size_t threads)
+                                                                    {
+                                                                       std::vector<size_t> offsets, kept(pts.size()), counts(pts.size() / 1000 + 1);
+
+                                                                       for (size_t i = 0; i < pts.size(); i += 1000)
+                                                                       {
+                                                                          offsets.push_back(i);
+                                                                       }
+
+                                                                       offsets.push_back(pts.size());
+                                                                       return cg::simplify_polylines(pts.begin(), offsets.begin(), offsets.end(), 1.,
+                                                                                                     kept.begin(), counts.begin(), threads);
+                                                                    }},
+   };
+
+   // thread scaling on the largest input of up to 4M points
+   for (parallel_algorithm const & a : parallel_algorithms)
+   {
+      size_t n = std::min<size_t>(max_n, 4000000);
+      random_t random(n);
+      points_t const input = a.input.generate(n, random);
+
+      for (size_t threads = 1; threads <= 64; threads *= 2)
+      {
+         result r = {a.name, a.input.name, n, threads, 3, 0, 0};
+         measure(r, input, [&a, threads] (points_t & pts) { return a.run(pts, threads); });
+
+         std::cerr << a.name << ", " << threads << " threads, n = " << n << ": " << r.seconds << " s" << std::endl;
+         results.push_back(r);
+      }
+   }
+
+   // 3d hull up to 10^6 points. the target is 10^6 points in a second: the cube is far
+   // below it, the sphere (every point on the hull) is still above it
+   for (auto d : {std::make_pair("uniform_cube", uniform_cube), std::make_pair("sphere", sphere)})
+   {
+      for (size_t n = 1000; n <= std::min<size_t>(max_n, 1000000); n *= 10)
+      {
+         random_t random(n);
+         points_3_t const input = d.second(n, random);
+
+         result r = {"convex_hull_3", d.first, n, 1, (n < 1000000) ? 5u : 1u, 0, 0};
+         measure(r, input, [] (points_3_t & pts) { return cg::convex_hull_3(pts.begin(), pts.end()).size(); });
+
+         std::cerr << d.first << ", convex_hull_3, n = " << n << ": " << r.seconds << " s" << std::endl;
+         results.push_back(r);
+      }
+   }
+
+   if (argc > 2)
+   {
+      std::ofstream out(argv[2]);
+      write_json(out, results);
+   }
+   else
+   {
+      write_json(std::cout, results);
+   }
+
+   return 0;
+}
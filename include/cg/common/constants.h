@@ -0,0 +1,7 @@
+#pragma once
+
+namespace cg
+{
+   // M_PI is not part of standard c++
+   double const pi = 3.14159265358979323846;
+}
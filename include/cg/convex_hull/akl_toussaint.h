@@ -0,0 +1,113 @@
+#pragma once
+
+#include <iterator>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <cg/operations/orientation.h>
+
+namespace cg
+{
+   // pass as the last argument of a hull algorithm to run akl_toussaint_filter first
+   struct akl_toussaint_prefilter_t {};
+   const akl_toussaint_prefilter_t akl_toussaint_prefilter = akl_toussaint_prefilter_t();
+
+   // moves to the end every point lying strictly inside the polygon of the extreme
+   // points in eight directions (axes and diagonals), such points are never on the hull.
+   // returns the end of the remaining points, their hull is the hull of the whole range
+   template <class RandIter>
+   RandIter akl_toussaint_filter(RandIter p, RandIter q)
+   {
+      typedef typename std::iterator_traits<RandIter>::value_type point;
+
+      if (std::distance(p, q) < 9)
+      {
+         return q;
+      }
+
+      // directions in counterclockwise order: -y, x - y, x, x + y, y, y - x, -x, -x - y
+      std::array<RandIter, 8> extreme;
+      extreme.fill(p);
+
+      for (RandIter it = p; it != q; ++it)
+      {
+         point const & a = *it;
+
+         if (a.y < extreme[0]->y)
+         {
+            extreme[0] = it;
+         }
+
+         if (a.x - a.y > extreme[1]->x - extreme[1]->y)
+         {
+            extreme[1] = it;
+         }
+
+         if (a.x > extreme[2]->x)
+         {
+            extreme[2] = it;
+         }
+
+         if (a.x + a.y > extreme[3]->x + extreme[3]->y)
+         {
+            extreme[3] = it;
+         }
+
+         if (a.y > extreme[4]->y)
+         {
+            extreme[4] = it;
+         }
+
+         if (a.y - a.x > extreme[5]->y - extreme[5]->x)
+         {
+            extreme[5] = it;
+         }
+
+         if (a.x < extreme[6]->x)
+         {
+            extreme[6] = it;
+         }
+
+         if (a.x + a.y < extreme[7]->x + extreme[7]->y)
+         {
+            extreme[7] = it;
+         }
+      }
+
+      std::vector<point> polygon;
+
+      for (RandIter it : extreme)
+      {
+         if (polygon.empty() || polygon.back() != *it)
+         {
+            polygon.push_back(*it);
+         }
+      }
+
+      while (polygon.size() > 1 && polygon.back() == polygon.front())
+      {
+         polygon.pop_back();
+      }
+
+      if (polygon.size() < 3)
+      {
+         return q;
+      }
+
+      // a point strictly to the left of every edge has positive winding number,
+      // so it is inside the hull even if rounding picked slightly wrong extremes
+      return std::partition(p, q, [&polygon] (point const & a)
+      {
+         for (size_t i = 0, j = polygon.size() - 1; i != polygon.size(); j = i++)
+         {
+            if (orientation(polygon[j], polygon[i], a) != CG_LEFT)
+            {
+               return true;
+            }
+         }
+
+         return false;
+      });
+   }
+}
@@ -35,4 +35,10 @@ namespace cg
 
       return contour_graham_hull(p, q);
    }
+
+   template <class RandIter>
+   RandIter andrew_hull(RandIter p, RandIter q, akl_toussaint_prefilter_t)
+   {
+      return andrew_hull(p, akl_toussaint_filter(p, q));
+   }
 }
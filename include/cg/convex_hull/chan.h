@@ -0,0 +1,280 @@
+#pragma once
+
+#include <iterator>
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+#include <cg/operations/orientation.h>
+
+#include "andrew.h"
+
+namespace cg
+{
+   namespace detail
+   {
+      // permutes [p, q) so that *where[i] is moved to p + i, where are distinct
+      template <class RandIter>
+      void move_to_front(RandIter p, std::vector<RandIter> where)
+      {
+         std::unordered_map<size_t, size_t> owner;
+
+         for (size_t i = 0; i != where.size(); ++i)
+         {
+            owner[where[i] - p] = i;
+         }
+
+         for (size_t i = 0; i != where.size(); ++i)
+         {
+            RandIter target = p + i;
+
+            if (where[i] == target)
+            {
+               continue;
+            }
+
+            auto displaced = owner.find(i);
+
+            if (displaced != owner.end())
+            {
+               where[displaced->second] = where[i];
+               owner[where[i] - p] = displaced->second;
+            }
+
+            std::iter_swap(target, where[i]);
+         }
+      }
+
+      // true if b is a better next hull vertex than a when wrapping around from c
+      template <class Point>
+      bool chan_better(Point const & c, Point const & a, Point const & b)
+      {
+         switch (orientation(c, a, b))
+         {
+         case CG_RIGHT:
+            return true;
+
+         case CG_LEFT:
+            return false;
+
+         default:
+            return collinear_are_ordered_along_line(c, a, b) && a != b;
+         }
+      }
+
+      // index of the vertex v of the ccw convex polygon h[0..n) such that
+      // no vertex of h lies to the right of c -> v, c is outside of h
+      template <class RandIter, class Point>
+      size_t chan_tangent(RandIter h, size_t n, Point const & c)
+      {
+         auto v = [h, n] (size_t i) -> Point const &
+         {
+            return h[i % n];
+         };
+
+         auto above = [&c] (Point const & a, Point const & b)
+         {
+            return orientation(c, a, b) == CG_LEFT;
+         };
+
+         auto below = [&c] (Point const & a, Point const & b)
+         {
+            return orientation(c, a, b) == CG_RIGHT;
+         };
+
+         auto is_tangent = [&] (size_t i)
+         {
+            return v(i) != c && !below(v(i), v(i + 1)) && !below(v(i), v(i + n - 1));
+         };
+
+         size_t res = n;
+
+         if (n >= 8)
+         {
+            // binary search of the right tangent, see Dan Sunday, "tangents to a convex polygon"
+            if (below(v(1), v(0)) && !above(v(n - 1), v(0)))
+            {
+               res = 0;
+            }
+
+            for (size_t a = 0, b = n, steps = 0; res == n && steps != 64 && b - a > 1; ++steps)
+            {
+               size_t m = (a + b) / 2;
+               bool down_m = below(v(m + 1), v(m));
+
+               if (down_m && !above(v(m + n - 1), v(m)))
+               {
+                  res = m;
+                  break;
+               }
+
+               if (above(v(a + 1), v(a)))
+               {
+                  if (down_m || above(v(a), v(m)))
+                  {
+                     b = m;
+                  }
+                  else
+                  {
+                     a = m;
+                  }
+               }
+               else
+               {
+                  if (down_m && below(v(a), v(m)))
+                  {
+                     b = m;
+                  }
+                  else
+                  {
+                     a = m;
+                  }
+               }
+            }
+         }
+
+         // degenerate configurations (collinear vertices, c on the polygon) are scanned
+         if (res == n || !is_tangent(res))
+         {
+            res = n;
+
+            for (size_t i = 0; i != n; ++i)
+            {
+               if (v(i) != c && (res == n || chan_better(c, v(res), v(i))))
+               {
+                  res = i;
+               }
+            }
+
+            return res;
+         }
+
+         // among collinear tangent vertices take the farthest
+         for (size_t i = 0; i != n && chan_better(c, v(res), v(res + 1)); ++i)
+         {
+            res = (res + 1) % n;
+         }
+
+         for (size_t i = 0; i != n && chan_better(c, v(res), v(res + n - 1)); ++i)
+         {
+            res = (res + n - 1) % n;
+         }
+
+         return res;
+      }
+   }
+
+   // output sensitive O(n log h) hull: jarvis march over andrew_hull mini hulls
+   // of m points with tangent binary searches, m is squared until m >= h
+   template <class RandIter>
+   RandIter chan_hull(RandIter p, RandIter q)
+   {
+      typedef typename std::iterator_traits<RandIter>::value_type point;
+
+      size_t n = std::distance(p, q);
+
+      if (n < 16)
+      {
+         return andrew_hull(p, q);
+      }
+
+      point const start = *std::min_element(p, q);
+
+      for (size_t m = 16; ; m = (m >= n / m) ? n : m * m)
+      {
+         if (m >= n)
+         {
+            return andrew_hull(p, q);
+         }
+
+         std::vector<std::pair<RandIter, size_t> > hulls;
+
+         for (RandIter g = p; g != q; )
+         {
+            RandIter e = (size_t(q - g) > m) ? g + m : q;
+            hulls.push_back(std::make_pair(g, size_t(andrew_hull(g, e) - g)));
+            g = e;
+         }
+
+         size_t cur_hull = 0;
+
+         while (*hulls[cur_hull].first != start)
+         {
+            ++cur_hull;
+         }
+
+         // vertices of the result as (mini hull, index in it)
+         std::vector<std::pair<size_t, size_t> > result(1, std::make_pair(cur_hull, size_t(0)));
+         bool closed = false;
+
+         for (size_t step = 0; step != m && !closed; ++step)
+         {
+            point const cur = hulls[result.back().first].first[result.back().second];
+            std::pair<size_t, size_t> next(hulls.size(), 0);
+
+            for (size_t h = 0; h != hulls.size(); ++h)
+            {
+               RandIter hb = hulls[h].first;
+               size_t hn = hulls[h].second;
+               size_t candidate;
+
+               if (h == result.back().first)
+               {
+                  if (hn == 1)
+                  {
+                     continue;
+                  }
+
+                  candidate = (result.back().second + 1) % hn;
+               }
+               else
+               {
+                  candidate = detail::chan_tangent<RandIter, point>(hb, hn, cur);
+
+                  if (candidate == hn)
+                  {
+                     continue;
+                  }
+               }
+
+               if (hb[candidate] == cur)
+               {
+                  continue;
+               }
+
+               if (next.first == hulls.size()
+                   || detail::chan_better(cur, hulls[next.first].first[next.second], hb[candidate]))
+               {
+                  next = std::make_pair(h, candidate);
+               }
+            }
+
+            if (next.first == hulls.size() || hulls[next.first].first[next.second] == start)
+            {
+               closed = true;
+            }
+            else
+            {
+               result.push_back(next);
+            }
+         }
+
+         if (!closed)
+         {
+            continue;
+         }
+
+         // move the hull to the beginning of the range
+         std::vector<RandIter> where;
+
+         for (size_t i = 0; i != result.size(); ++i)
+         {
+            where.push_back(hulls[result[i].first].first + result[i].second);
+         }
+
+         detail::move_to_front(p, where);
+         return p + result.size();
+      }
+   }
+}
@@ -0,0 +1,709 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <cg/primitives/point_3.h>
+#include <cg/operations/orientation_3.h>
+
+namespace cg
+{
+   // triangle of a mesh given by the indices of its vertices
+   typedef std::array<size_t, 3> indexed_triangle;
+
+   namespace detail
+   {
+      // the low 21 bits of x spread to every third bit
+      inline uint64_t spread_bits_3(uint64_t x)
+      {
+         x &= 0x1fffff;
+         x = (x | x << 32) & 0x1f00000000ffffULL;
+         x = (x | x << 16) & 0x1f0000ff0000ffULL;
+         x = (x | x << 8) & 0x100f00f00f00f00fULL;
+         x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+         x = (x | x << 2) & 0x1249249249249249ULL;
+         return x;
+      }
+
+      // the indices ids of the points of p sorted along a z-order curve
+      template <class RandIter>
+      std::vector<size_t> z_order(RandIter p, std::vector<size_t> const & ids)
+      {
+         double min[3], max[3];
+
+         for (size_t k = 0; k != ids.size(); ++k)
+         {
+            size_t i = ids[k];
+            double c[3] = {double(p[i].x), double(p[i].y), double(p[i].z)};
+
+            for (size_t j = 0; j != 3; ++j)
+            {
+               min[j] = (k == 0) ? c[j] : std::min(min[j], c[j]);
+               max[j] = (k == 0) ? c[j] : std::max(max[j], c[j]);
+            }
+         }
+
+         double extent = 0;
+
+         for (size_t j = 0; !ids.empty() && j != 3; ++j)
+         {
+            extent = std::max(extent, max[j] - min[j]);
+         }
+
+         double scale = (extent > 0) ? 0x1fffff / extent : 0;
+         std::vector<std::pair<uint64_t, size_t> > keys(ids.size());
+
+         for (size_t k = 0; k != ids.size(); ++k)
+         {
+            size_t i = ids[k];
+            uint64_t x = uint64_t((double(p[i].x) - min[0]) * scale);
+            uint64_t y = uint64_t((double(p[i].y) - min[1]) * scale);
+            uint64_t z = uint64_t((double(p[i].z) - min[2]) * scale);
+            keys[k] = std::make_pair(spread_bits_3(x) | spread_bits_3(y) << 1 | spread_bits_3(z) << 2, i);
+         }
+
+         std::sort(keys.begin(), keys.end());
+
+         std::vector<size_t> res(ids.size());
+
+         for (size_t k = 0; k != ids.size(); ++k)
+         {
+            res[k] = keys[k].second;
+         }
+
+         return res;
+      }
+
+      // the plane through a, b, c in doubles: n * p - d is within m * |p| + e (twice the
+      // rounding error) of det(b - a, c - a, p - a), so its sign is the orientation of p
+      // unless they are close
+      struct plane_3
+      {
+         std::array<double, 3> n, m;
+         double d, e;
+
+         template <class Scalar>
+         plane_3(point_3t<Scalar> const & a, point_3t<Scalar> const & b, point_3t<Scalar> const & c)
+         {
+            double ux = double(b.x) - a.x, uy = double(b.y) - a.y, uz = double(b.z) - a.z;
+            double vx = double(c.x) - a.x, vy = double(c.y) - a.y, vz = double(c.z) - a.z;
+            double k = 8 * std::numeric_limits<double>::epsilon();
+
+            n = {{uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx}};
+            m = {{k * (std::fabs(uy * vz) + std::fabs(uz * vy)),
+                  k * (std::fabs(uz * vx) + std::fabs(ux * vz)),
+                  k * (std::fabs(ux * vy) + std::fabs(uy * vx))}};
+            d = n[0] * a.x + n[1] * a.y + n[2] * a.z;
+            e = m[0] * std::fabs(double(a.x)) + m[1] * std::fabs(double(a.y)) + m[2] * std::fabs(double(a.z));
+         }
+
+         // none if the points are too close to the plane
+         template <class Scalar>
+         boost::optional<orientation_t> orientation(point_3t<Scalar> const & p) const
+         {
+            double x = p.x, y = p.y, z = p.z;
+            double v = n[0] * x + n[1] * y + n[2] * z - d;
+            double err = m[0] * std::fabs(x) + m[1] * std::fabs(y) + m[2] * std::fabs(z) + e;
+
+            if (v > err)
+            {
+               return CG_LEFT;
+            }
+
+            if (v < -err)
+            {
+               return CG_RIGHT;
+            }
+
+            return boost::none;
+         }
+      };
+
+      // akl-toussaint in 3d: the points of [p, p + n) extreme in the directions of the
+      // axes and of the diagonals of a cube come first (their number is written to
+      // extremes), then the other points not inside of their hull. the faces of the hull
+      // are found among the triples of the extreme points, nothing is dropped if these
+      // are coplanar
+      template <class RandIter>
+      std::vector<size_t> hull_3_candidates(RandIter p, size_t n, size_t & extremes)
+      {
+         typedef typename std::iterator_traits<RandIter>::value_type point;
+
+         static const int dirs[7][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {-1, 1, 1}};
+
+         std::vector<size_t> res;
+         extremes = 0;
+
+         if (n == 0)
+         {
+            return res;
+         }
+
+         size_t lo[7] = {}, hi[7] = {};
+         double min[7], max[7];
+
+         for (size_t i = 0; i != n; ++i)
+         {
+            for (size_t k = 0; k != 7; ++k)
+            {
+               double v = dirs[k][0] * double(p[i].x) + dirs[k][1] * double(p[i].y) + dirs[k][2] * double(p[i].z);
+
+               if (i == 0 || v < min[k])
+               {
+                  min[k] = v;
+                  lo[k] = i;
+               }
+
+               if (i == 0 || v > max[k])
+               {
+                  max[k] = v;
+                  hi[k] = i;
+               }
+            }
+         }
+
+         std::vector<point> ext;
+
+         for (size_t k = 0; k != 7; ++k)
+         {
+            for (size_t i : {lo[k], hi[k]})
+            {
+               if (std::find(res.begin(), res.end(), i) == res.end())
+               {
+                  res.push_back(i);
+                  ext.push_back(p[i]);
+               }
+            }
+         }
+
+         extremes = res.size();
+
+         // the planes of the triples with all the extreme points on the right or on them
+         std::vector<plane_3> faces;
+         std::vector<std::array<size_t, 3> > triples;
+         bool solid = false;
+
+         for (size_t a = 0; a != ext.size(); ++a)
+         {
+            for (size_t b = a + 1; b != ext.size(); ++b)
+            {
+               for (size_t c = b + 1; c != ext.size(); ++c)
+               {
+                  bool left = false, right = false;
+
+                  for (point const & x : ext)
+                  {
+                     orientation_t o = cg::orientation(ext[a], ext[b], ext[c], x);
+                     left = left || o == CG_LEFT;
+                     right = right || o == CG_RIGHT;
+                  }
+
+                  solid = solid || left || right;
+
+                  if (left != right)
+                  {
+                     size_t u = left ? c : b, w = left ? b : c;
+                     faces.push_back(plane_3(ext[a], ext[u], ext[w]));
+                     triples.push_back({{a, u, w}});
+                  }
+               }
+            }
+         }
+
+         for (size_t i = 0; i != n; ++i)
+         {
+            bool outside = !solid;
+
+            for (size_t f = 0; f != faces.size() && !outside; ++f)
+            {
+               boost::optional<orientation_t> o = faces[f].orientation(p[i]);
+
+               if (!o)
+               {
+                  std::array<size_t, 3> const & t = triples[f];
+                  o = cg::orientation(ext[t[0]], ext[t[1]], ext[t[2]], point(p[i]));
+               }
+
+               outside = *o == CG_LEFT;
+            }
+
+            if (outside && std::find(res.begin(), res.begin() + extremes, i) == res.begin() + extremes)
+            {
+               res.push_back(i);
+            }
+         }
+
+         return res;
+      }
+
+      // randomized incremental hull, every point outside of the current hull is assigned
+      // to one face it sees. a new point removes the faces it sees (found from its face
+      // by a search over the adjacency), their points are assigned again.
+      //
+      // a point j of a removed face is tested only at the horizon edges reached by a
+      // search over the removed faces j sees, against the new face and the old face
+      // there. if j sees an old face, the first old one on a path from the removed face
+      // over the (connected) faces j sees is behind such an edge. otherwise j sees a new
+      // face and so the removed face at its edge, which is reached the same way.
+      //
+      // only the candidates of hull_3_candidates are used. the hull of the extreme ones
+      // is built first, the others are inserted in rounds of a biased randomized order.
+      // the points are numbered along a z-order curve, so is the order within a round,
+      // and the point lists of the faces share one pool with copies of the points, so
+      // the data of a face are close in memory. the pool is compacted when most of it is
+      // unused, faces are reused. a face keeps its plane_3 for a fast orientation test
+      template <class RandIter>
+      class hull_3_builder
+      {
+         typedef typename std::iterator_traits<RandIter>::value_type::scalar_type scalar;
+
+         struct face
+         {
+            // counterclockwise seen from the outside
+            std::array<size_t, 3> v;
+            // adj[i] is the face across the edge v[i], v[i + 1]. a removed face refers to
+            // the new faces at its horizon edges, their adj[0] is the old face there
+            std::array<size_t, 3> adj;
+            // first node of the list of the points assigned to the face
+            size_t outside;
+            // removed by the insertion with this stamp, visited by the search with walk
+            size_t mark, walk;
+            bool alive;
+            plane_3 plane;
+         };
+
+         struct node
+         {
+            point_3t<scalar> pt;
+            size_t id, next;
+         };
+
+         static size_t none()
+         {
+            return size_t(-1);
+         }
+
+         bool sees(point_3t<scalar> const & p, size_t f) const
+         {
+            face const & fc = faces_[f];
+
+            if (boost::optional<orientation_t> o = fc.plane.orientation(p))
+            {
+               return *o == CG_LEFT;
+            }
+
+            return orientation(pts_[fc.v[0]], pts_[fc.v[1]], pts_[fc.v[2]], p) == CG_LEFT;
+         }
+
+         // the faces removed by insert are reused
+         size_t add_face(size_t a, size_t b, size_t c)
+         {
+            face f = {{{a, b, c}}, {{none(), none(), none()}}, none(), 0, 0, true, plane_3(pts_[a], pts_[b], pts_[c])};
+
+            if (free_.empty())
+            {
+               faces_.push_back(f);
+               return faces_.size() - 1;
+            }
+
+            size_t res = free_.back();
+            free_.pop_back();
+            faces_[res] = f;
+            return res;
+         }
+
+         void assign(point_3t<scalar> const & p, size_t i, size_t f)
+         {
+            node nd = {p, i, faces_[f].outside};
+            nodes_.push_back(nd);
+            faces_[f].outside = nodes_.size() - 1;
+            conflict_[i] = f;
+            ++live_;
+         }
+
+         // the lists of the alive faces are copied to the beginning of the pool
+         void compact()
+         {
+            std::vector<node> & res = compacted_;
+            res.clear();
+            res.reserve(2 * live_ + faces_.size());
+
+            for (face & f : faces_)
+            {
+               if (!f.alive || f.outside == none())
+               {
+                  continue;
+               }
+
+               size_t k = f.outside;
+               f.outside = res.size();
+
+               for (; k != none(); k = nodes_[k].next)
+               {
+                  res.push_back(nodes_[k]);
+                  res.back().next = res.size();
+               }
+
+               res.back().next = none();
+            }
+
+            nodes_.swap(res);
+         }
+
+         // the point of the node nd of the face f removed by the last insertion
+         void reassign(node const & nd, size_t f)
+         {
+            point_3t<scalar> const & p = nd.pt;
+            walk_.clear();
+            walk_.push_back(f);
+            faces_[f].walk = ++walk_stamp_;
+
+            for (size_t k = 0; k != walk_.size(); ++k)
+            {
+               face const & fc = faces_[walk_[k]];
+
+               // the new faces at the horizon edges first
+               for (size_t g : fc.adj)
+               {
+                  if (faces_[g].mark != stamp_ && sees(p, g))
+                  {
+                     assign(p, nd.id, g);
+                     return;
+                  }
+               }
+
+               for (size_t g : fc.adj)
+               {
+                  if (faces_[g].mark != stamp_)
+                  {
+                     if (sees(p, faces_[g].adj[0]))
+                     {
+                        assign(p, nd.id, faces_[g].adj[0]);
+                        return;
+                     }
+                  }
+                  else if (faces_[g].walk != walk_stamp_ && sees(p, g))
+                  {
+                     faces_[g].walk = walk_stamp_;
+                     walk_.push_back(g);
+                  }
+               }
+            }
+
+            // inside of the hull now
+            conflict_[nd.id] = none();
+         }
+
+         // the point i is assigned to the first face of faces it sees if any
+         void assign_to(size_t i, std::vector<size_t> const & faces)
+         {
+            for (size_t f : faces)
+            {
+               if (sees(pts_[i], f))
+               {
+                  assign(pts_[i], i, f);
+                  return;
+               }
+            }
+         }
+
+         // first four points of order in general position are moved to its beginning
+         bool find_simplex()
+         {
+            size_t found = 1;
+
+            for (size_t k = 1; k != order_.size() && found != 4; ++k)
+            {
+               point_3t<scalar> const & a = pts_[order_[0]];
+               point_3t<scalar> const & b = pts_[order_[1]];
+               point_3t<scalar> const & c = pts_[order_[2]];
+               point_3t<scalar> const & x = pts_[order_[k]];
+
+               bool good = (found == 1 && x != a)
+                        || (found == 2 && !collinear(a, b, x))
+                        || (found == 3 && orientation(a, b, c, x) != CG_COLLINEAR);
+
+               if (good)
+               {
+                  std::swap(order_[found++], order_[k]);
+               }
+            }
+
+            return found == 4;
+         }
+
+         void insert(size_t i)
+         {
+            size_t start = conflict_[i];
+
+            if (start == none())
+            {
+               return;
+            }
+
+            ++stamp_;
+            visible_.assign(1, start);
+            faces_[start].mark = stamp_;
+            new_faces_.clear();
+
+            for (size_t k = 0; k != visible_.size(); ++k)
+            {
+               size_t f = visible_[k];
+
+               for (size_t e = 0; e != 3; ++e)
+               {
+                  size_t g = faces_[f].adj[e];
+
+                  if (faces_[g].mark == stamp_)
+                  {
+                     continue;
+                  }
+
+                  if (sees(pts_[i], g))
+                  {
+                     faces_[g].mark = stamp_;
+                     visible_.push_back(g);
+                     continue;
+                  }
+
+                  // horizon edge a -> b of f, the new face a, b, i replaces f at it
+                  size_t a = faces_[f].v[e], b = faces_[f].v[(e + 1) % 3];
+                  size_t n = add_face(a, b, i);
+                  faces_[n].adj[0] = g;
+                  faces_[f].adj[e] = n;
+
+                  for (size_t j = 0; j != 3; ++j)
+                  {
+                     if (faces_[g].adj[j] == f && faces_[g].v[j] == b)
+                     {
+                        faces_[g].adj[j] = n;
+                     }
+                  }
+
+                  by_start_[a] = n;
+                  new_faces_.push_back(n);
+               }
+            }
+
+            for (size_t n : new_faces_)
+            {
+               size_t next = by_start_[faces_[n].v[1]];
+               faces_[n].adj[1] = next;
+               faces_[next].adj[2] = n;
+            }
+
+            for (size_t f : visible_)
+            {
+               faces_[f].alive = false;
+            }
+
+            for (size_t f : visible_)
+            {
+               for (size_t k = faces_[f].outside; k != none(); k = nodes_[k].next)
+               {
+                  --live_;
+
+                  if (nodes_[k].id != i)
+                  {
+                     // nodes_ may grow
+                     node const nd = nodes_[k];
+                     reassign(nd, f);
+                  }
+               }
+            }
+
+            free_.insert(free_.end(), visible_.begin(), visible_.end());
+            conflict_[i] = none();
+
+            if (nodes_.size() > 4 * live_ + faces_.size())
+            {
+               compact();
+            }
+         }
+
+      public:
+         hull_3_builder(RandIter p, RandIter q, uint64_t seed)
+            : live_(0)
+            , stamp_(0)
+            , walk_stamp_(0)
+         {
+            std::vector<size_t> const candidates = hull_3_candidates(p, std::distance(p, q), extremes_);
+            std::vector<size_t> const curve = z_order(p, candidates);
+            std::vector<size_t> extreme(candidates.begin(), candidates.begin() + extremes_);
+            std::sort(extreme.begin(), extreme.end());
+
+            size_t n = candidates.size();
+            index_ = curve;
+            conflict_.assign(n, none());
+            by_start_.assign(n, none());
+            pts_.reserve(n);
+
+            // biased randomized insertion order: the points go to rounds 0, -1, -2, ...
+            // with probabilities 1/2, 1/4, 1/8, ... and are inserted round by round along
+            // the curve, the extreme points before all of them
+            std::mt19937_64 random(seed);
+            std::vector<std::pair<int, size_t> > rounds(n);
+
+            for (size_t i = 0; i != n; ++i)
+            {
+               pts_.push_back(p[curve[i]]);
+
+               int round = 0;
+
+               for (uint64_t x = random(); x & 1; x >>= 1)
+               {
+                  --round;
+               }
+
+               if (std::binary_search(extreme.begin(), extreme.end(), curve[i]))
+               {
+                  round = std::numeric_limits<int>::min();
+               }
+
+               rounds[i] = std::make_pair(round, i);
+            }
+
+            std::sort(rounds.begin(), rounds.end());
+            order_.resize(n);
+
+            for (size_t i = 0; i != n; ++i)
+            {
+               order_[i] = rounds[i].second;
+            }
+         }
+
+         std::vector<indexed_triangle> build()
+         {
+            std::vector<indexed_triangle> res;
+
+            if (order_.size() < 4 || !find_simplex())
+            {
+               return res;
+            }
+
+            size_t a = order_[0], b = order_[1], c = order_[2], d = order_[3];
+
+            if (orientation(pts_[a], pts_[b], pts_[c], pts_[d]) == CG_LEFT)
+            {
+               std::swap(b, c);
+            }
+
+            // d is below a, b, c, so every face below is seen counterclockwise from the outside
+            add_face(a, b, c);
+            add_face(a, d, b);
+            add_face(b, d, c);
+            add_face(c, d, a);
+
+            for (size_t f = 0; f != 4; ++f)
+            {
+               for (size_t e = 0; e != 3; ++e)
+               {
+                  for (size_t g = 0; g != 4; ++g)
+                  {
+                     for (size_t j = 0; j != 3; ++j)
+                     {
+                        if (faces_[g].v[j] == faces_[f].v[(e + 1) % 3] && faces_[g].v[(j + 1) % 3] == faces_[f].v[e])
+                        {
+                           faces_[f].adj[e] = g;
+                        }
+                     }
+                  }
+               }
+            }
+
+            // the hull of the extreme points is built first, the other points are assigned
+            // to its faces afterwards
+            size_t first = std::max<size_t>(extremes_, 4);
+            std::vector<size_t> hull(4);
+
+            for (size_t f = 0; f != 4; ++f)
+            {
+               hull[f] = f;
+            }
+
+            for (size_t k = 4; k < first; ++k)
+            {
+               assign_to(order_[k], hull);
+            }
+
+            for (size_t k = 4; k < first; ++k)
+            {
+               insert(order_[k]);
+            }
+
+            hull.clear();
+
+            for (size_t f = 0; f != faces_.size(); ++f)
+            {
+               if (faces_[f].alive)
+               {
+                  hull.push_back(f);
+               }
+            }
+
+            std::vector<bool> early(order_.size(), false);
+
+            for (size_t k = 0; k < first; ++k)
+            {
+               early[order_[k]] = true;
+            }
+
+            nodes_.reserve(order_.size());
+
+            // in the order of the curve, so the lists of the faces follow it
+            for (size_t i = 0; i != order_.size(); ++i)
+            {
+               if (!early[i])
+               {
+                  assign_to(i, hull);
+               }
+            }
+
+            for (size_t k = first; k < order_.size(); ++k)
+            {
+               insert(order_[k]);
+            }
+
+            for (face const & f : faces_)
+            {
+               if (f.alive)
+               {
+                  res.push_back({{index_[f.v[0]], index_[f.v[1]], index_[f.v[2]]}});
+               }
+            }
+
+            return res;
+         }
+
+      private:
+         // the points along the curve, index_ of a point is its index in the input
+         std::vector<point_3t<scalar> > pts_;
+         std::vector<size_t> order_, index_;
+         std::vector<face> faces_;
+         // live_ nodes of the pool are in the lists of the faces
+         std::vector<node> nodes_, compacted_;
+         std::vector<size_t> conflict_;
+         std::vector<size_t> by_start_;
+         std::vector<size_t> visible_, new_faces_, walk_, free_;
+         size_t extremes_, live_, stamp_, walk_stamp_;
+      };
+   }
+
+   // convex hull of the points [p, q) as a triangle mesh, vertices are the indices of
+   // the points, triangles are counterclockwise seen from the outside.
+   // no triangles if the points are coplanar. points on the boundary of the hull may be
+   // vertices of coplanar triangles, duplicates are not. O(n log n) expected
+   template <class RandIter>
+   std::vector<indexed_triangle> convex_hull_3(RandIter p, RandIter q, uint64_t seed = 0)
+   {
+      return detail::hull_3_builder<RandIter>(p, q, seed).build();
+   }
+}
@@ -0,0 +1,675 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <gmpxx.h>
+
+#include <cg/primitives/point.h>
+#include <cg/primitives/vector.h>
+#include <cg/operations/orientation.h>
+
+namespace cg
+{
+   template <class Scalar>
+   class dynamic_hull_2t;
+
+   typedef dynamic_hull_2t<double> dynamic_hull_2;
+
+   // fully dynamic convex hull (overmars, van leeuwen).
+   //
+   // points are kept in the leaves of a weight balanced tree in lexicographical order,
+   // every inner node stores the bridges of the upper and lower hulls of its subtrees.
+   // the hull of a subtree is the hull of the left child up to the bridge followed by
+   // the hull of the right child after it, so hull queries are descents along bridges.
+   //
+   // insert and erase are O(log^2 n) amortized, extreme point and tangent queries
+   // are O(log n), traversal is O(h log n)
+   template <class Scalar>
+   class dynamic_hull_2t
+   {
+      typedef point_2t<Scalar> point;
+      typedef boost::optional<point> bound;
+
+      enum chain_t
+      {
+         UPPER = 0,
+         LOWER = 1
+      };
+
+      struct node
+      {
+         // leaf: the point, inner node: the largest point of the left subtree
+         point p;
+         size_t left, right, parent;
+         size_t size;
+         std::pair<point, point> bridge[2];
+      };
+
+      static size_t none()
+      {
+         return size_t(-1);
+      }
+
+      // orientation for the upper chain, mirrored for the lower one
+      static orientation_t turn(chain_t c, point const & a, point const & b, point const & d)
+      {
+         orientation_t res = orientation(a, b, d);
+         return (c == UPPER) ? res : orientation_t(-res);
+      }
+
+      // true if b is to the side of q -> a, or on it and farther from q
+      static bool better(point const & q, point const & a, point const & b, orientation_t side)
+      {
+         orientation_t res = orientation(q, a, b);
+
+         if (res == CG_COLLINEAR)
+         {
+            return collinear_are_ordered_along_line(q, a, b) && a != b;
+         }
+
+         return res == side;
+      }
+
+      bool leaf(size_t v) const
+      {
+         return nodes_[v].left == none();
+      }
+
+      size_t new_node(size_t parent)
+      {
+         size_t v;
+
+         if (free_.empty())
+         {
+            v = nodes_.size();
+            nodes_.push_back(node());
+         }
+         else
+         {
+            v = free_.back();
+            free_.pop_back();
+         }
+
+         nodes_[v].left = nodes_[v].right = none();
+         nodes_[v].parent = parent;
+         nodes_[v].size = 1;
+         return v;
+      }
+
+      size_t new_leaf(point const & p, size_t parent)
+      {
+         size_t v = new_node(parent);
+         nodes_[v].p = p;
+         nodes_[v].bridge[UPPER] = nodes_[v].bridge[LOWER] = std::make_pair(p, p);
+         return v;
+      }
+
+      void replace_child(size_t parent, size_t old_child, size_t new_child)
+      {
+         if (parent == none())
+         {
+            root_ = new_child;
+         }
+         else if (nodes_[parent].left == old_child)
+         {
+            nodes_[parent].left = new_child;
+         }
+         else
+         {
+            nodes_[parent].right = new_child;
+         }
+      }
+
+      // vertex t of the chain of subtree v such that no point of v is above a -> t,
+      // a is less than every point of v. among collinear vertices the farthest is taken
+      point tangent_from(size_t v, chain_t c, point const & a) const
+      {
+         while (!leaf(v))
+         {
+            std::pair<point, point> const & br = nodes_[v].bridge[c];
+            v = (turn(c, a, br.first, br.second) == CG_RIGHT) ? nodes_[v].left : nodes_[v].right;
+         }
+
+         return nodes_[v].p;
+      }
+
+      // vertex t of the chain of subtree v such that no point of v is above t -> b,
+      // b is greater than every point of v. among collinear vertices the farthest is taken
+      point tangent_to(size_t v, chain_t c, point const & b) const
+      {
+         while (!leaf(v))
+         {
+            std::pair<point, point> const & br = nodes_[v].bridge[c];
+            v = (turn(c, br.first, br.second, b) == CG_RIGHT) ? nodes_[v].right : nodes_[v].left;
+         }
+
+         return nodes_[v].p;
+      }
+
+      // sign of x(intersection of lines a1 a2 and b1 b2) - m, the lines are not parallel
+      static int crossing_side(point const & a1, point const & a2, point const & b1, point const & b2, Scalar m)
+      {
+         Scalar ux = a2.x - a1.x, uy = a2.y - a1.y;
+         Scalar wx = b2.x - b1.x, wy = b2.y - b1.y;
+         Scalar dx = b1.x - a1.x, dy = b1.y - a1.y;
+         Scalar ox = a1.x - m;
+
+         Scalar den = ux * wy - uy * wx;
+         Scalar num = ox * den + ux * (dx * wy - dy * wx);
+         Scalar den_eps = (fabs(ux * wy) + fabs(uy * wx)) * 8 * std::numeric_limits<Scalar>::epsilon();
+         Scalar num_eps = (fabs(ox) * (fabs(ux * wy) + fabs(uy * wx))
+                           + fabs(ux) * (fabs(dx * wy) + fabs(dy * wx))) * 16 * std::numeric_limits<Scalar>::epsilon();
+
+         if (fabs(den) > den_eps && fabs(num) > num_eps)
+         {
+            return ((num > 0) == (den > 0)) ? 1 : -1;
+         }
+
+         mpq_class rux = mpq_class(a2.x) - a1.x, ruy = mpq_class(a2.y) - a1.y;
+         mpq_class rwx = mpq_class(b2.x) - b1.x, rwy = mpq_class(b2.y) - b1.y;
+         mpq_class rden = rux * rwy - ruy * rwx;
+         mpq_class rnum = (mpq_class(a1.x) - m) * rden
+                          + rux * ((mpq_class(b1.x) - a1.x) * rwy - (mpq_class(b1.y) - a1.y) * rwx);
+
+         return sgn(rnum) * sgn(rden);
+      }
+
+      // common tangent of the chains of subtrees l and r by the nested search, every point
+      // of l is less than every point of r. a vertex of l is not past the bridge if the next
+      // vertex is not above the tangent from it to r, this is monotone along the chain
+      std::pair<point, point> find_bridge_nested(size_t l, size_t r, chain_t c) const
+      {
+         while (!leaf(l))
+         {
+            std::pair<point, point> const & br = nodes_[l].bridge[c];
+            point t = tangent_from(r, c, br.first);
+            l = (turn(c, br.first, t, br.second) == CG_LEFT) ? nodes_[l].right : nodes_[l].left;
+         }
+
+         point const & a = nodes_[l].p;
+         return std::make_pair(a, tangent_from(r, c, a));
+      }
+
+      // common tangent of the chains of subtrees l and r, m separates them by x.
+      // descends in both subtrees at once comparing the chain edges at the current nodes:
+      // a point of one edge above the line of the other means the bridge is on the outer
+      // side of the other edge, otherwise the lines cross and the bridge is on the inner
+      // side of the edge whose line is higher at m. ties go to the nested search
+      std::pair<point, point> find_bridge(size_t l, size_t r, chain_t c, Scalar m) const
+      {
+         while (!leaf(l) && !leaf(r))
+         {
+            point const & a1 = nodes_[l].bridge[c].first;
+            point const & a2 = nodes_[l].bridge[c].second;
+            point const & b1 = nodes_[r].bridge[c].first;
+            point const & b2 = nodes_[r].bridge[c].second;
+
+            if (turn(c, a1, a2, b1) == CG_LEFT || turn(c, a1, a2, b2) == CG_LEFT)
+            {
+               l = nodes_[l].left;
+            }
+            else if (turn(c, b1, b2, a1) == CG_LEFT || turn(c, b1, b2, a2) == CG_LEFT)
+            {
+               r = nodes_[r].right;
+            }
+            else if (orientation(a1, a2, b1, b2) == CG_COLLINEAR)
+            {
+               return find_bridge_nested(l, r, c);
+            }
+            else
+            {
+               int side = crossing_side(a1, a2, b1, b2, m);
+
+               if (side == 0)
+               {
+                  return find_bridge_nested(l, r, c);
+               }
+
+               if (side < 0)
+               {
+                  l = nodes_[l].right;
+               }
+               else
+               {
+                  r = nodes_[r].left;
+               }
+            }
+         }
+
+         if (leaf(l))
+         {
+            point const & a = nodes_[l].p;
+            return std::make_pair(a, tangent_from(r, c, a));
+         }
+
+         point const & b = nodes_[r].p;
+         return std::make_pair(tangent_to(l, c, b), b);
+      }
+
+      void update_bridges(size_t v)
+      {
+         node const & n = nodes_[v];
+         std::pair<point, point> upper = find_bridge(n.left, n.right, UPPER, n.p.x);
+         std::pair<point, point> lower = find_bridge(n.left, n.right, LOWER, n.p.x);
+         nodes_[v].bridge[UPPER] = upper;
+         nodes_[v].bridge[LOWER] = lower;
+      }
+
+      void collect(size_t v, std::vector<point> & pts)
+      {
+         if (leaf(v))
+         {
+            pts.push_back(nodes_[v].p);
+         }
+         else
+         {
+            collect(nodes_[v].left, pts);
+            collect(nodes_[v].right, pts);
+         }
+
+         free_.push_back(v);
+      }
+
+      size_t build(std::vector<point> const & pts, size_t lo, size_t hi, size_t parent)
+      {
+         if (hi - lo == 1)
+         {
+            return new_leaf(pts[lo], parent);
+         }
+
+         size_t v = new_node(parent);
+         size_t mid = (lo + hi) / 2;
+         size_t l = build(pts, lo, mid, v);
+         size_t r = build(pts, mid, hi, v);
+
+         nodes_[v].p = pts[mid - 1];
+         nodes_[v].left = l;
+         nodes_[v].right = r;
+         nodes_[v].size = hi - lo;
+         update_bridges(v);
+         return v;
+      }
+
+      // restores sizes, balance and bridges on the path from v to the root
+      void fix_up(size_t v)
+      {
+         size_t unbalanced = none();
+
+         for (size_t u = v; u != none(); u = nodes_[u].parent)
+         {
+            node & n = nodes_[u];
+            size_t l = nodes_[n.left].size, r = nodes_[n.right].size;
+            n.size = l + r;
+
+            if (n.size > 4 && 4 * std::max(l, r) > 3 * n.size)
+            {
+               unbalanced = u;
+            }
+         }
+
+         if (unbalanced != none())
+         {
+            std::vector<point> pts;
+            size_t parent = nodes_[unbalanced].parent;
+            collect(unbalanced, pts);
+            replace_child(parent, unbalanced, build(pts, 0, pts.size(), parent));
+            v = parent;
+         }
+
+         for (size_t u = v; u != none(); u = nodes_[u].parent)
+         {
+            update_bridges(u);
+         }
+      }
+
+      // descent along the chain c of the hull restricted to [lo, hi].
+      // go_right(a, b) tells if the answer is after the chain edge a -> b
+      template <class GoRight>
+      bound descend(chain_t c, bound lo, bound hi, GoRight go_right) const
+      {
+         if (root_ == none())
+         {
+            return bound();
+         }
+
+         size_t v = root_;
+
+         while (!leaf(v))
+         {
+            point const & a = nodes_[v].bridge[c].first;
+            point const & b = nodes_[v].bridge[c].second;
+            bool a_in = !lo || *lo <= a;
+            bool b_in = !hi || b <= *hi;
+
+            if (!a_in && !b_in)
+            {
+               return bound();
+            }
+
+            if (a_in && (!b_in || !go_right(a, b)))
+            {
+               if (!hi || a < *hi)
+               {
+                  hi = a;
+               }
+
+               v = nodes_[v].left;
+            }
+            else
+            {
+               if (!lo || *lo < b)
+               {
+                  lo = b;
+               }
+
+               v = nodes_[v].right;
+            }
+         }
+
+         point const & p = nodes_[v].p;
+
+         if ((lo && p < *lo) || (hi && *hi < p))
+         {
+            return bound();
+         }
+
+         return p;
+      }
+
+      void chain(size_t v, chain_t c, bound lo, bound hi, std::vector<point> & out) const
+      {
+         if (leaf(v))
+         {
+            point const & p = nodes_[v].p;
+
+            if ((!lo || *lo <= p) && (!hi || p <= *hi))
+            {
+               out.push_back(p);
+            }
+
+            return;
+         }
+
+         point const & a = nodes_[v].bridge[c].first;
+         point const & b = nodes_[v].bridge[c].second;
+
+         if (!lo || *lo <= a)
+         {
+            chain(nodes_[v].left, c, lo, (hi && *hi < a) ? hi : bound(a), out);
+         }
+
+         if (!hi || b <= *hi)
+         {
+            chain(nodes_[v].right, c, (lo && b < *lo) ? lo : bound(b), hi, out);
+         }
+      }
+
+      // the largest vertex of the chain c not greater than q and the smallest not less than q
+      std::pair<bound, bound> neighbours(chain_t c, point const & q) const
+      {
+         bound prev = descend(c, bound(), bound(), [&q] (point const &, point const & b)
+         {
+            return b <= q;
+         });
+
+         bound next = descend(c, bound(), bound(), [&q] (point const & a, point const &)
+         {
+            return a < q;
+         });
+
+         return std::make_pair((prev && *prev <= q) ? prev : bound(),
+                               (next && q <= *next) ? next : bound());
+      }
+
+   public:
+      dynamic_hull_2t()
+         : root_(none())
+      {}
+
+      // returns false if p is already in the set
+      bool insert(point const & p)
+      {
+         if (root_ == none())
+         {
+            root_ = new_leaf(p, none());
+            return true;
+         }
+
+         size_t v = root_;
+
+         while (!leaf(v))
+         {
+            v = (p <= nodes_[v].p) ? nodes_[v].left : nodes_[v].right;
+         }
+
+         if (nodes_[v].p == p)
+         {
+            return false;
+         }
+
+         size_t parent = nodes_[v].parent;
+         size_t u = new_node(parent);
+         size_t l = new_leaf(p, u);
+         size_t a = v, b = l;
+
+         if (p < nodes_[v].p)
+         {
+            std::swap(a, b);
+         }
+
+         nodes_[v].parent = u;
+         nodes_[u].left = a;
+         nodes_[u].right = b;
+         nodes_[u].p = nodes_[a].p;
+         replace_child(parent, v, u);
+         fix_up(u);
+         return true;
+      }
+
+      // returns false if p is not in the set
+      bool erase(point const & p)
+      {
+         if (root_ == none())
+         {
+            return false;
+         }
+
+         size_t v = root_;
+
+         while (!leaf(v))
+         {
+            v = (p <= nodes_[v].p) ? nodes_[v].left : nodes_[v].right;
+         }
+
+         if (nodes_[v].p != p)
+         {
+            return false;
+         }
+
+         size_t u = nodes_[v].parent;
+         free_.push_back(v);
+
+         if (u == none())
+         {
+            root_ = none();
+            return true;
+         }
+
+         size_t sibling = (nodes_[u].left == v) ? nodes_[u].right : nodes_[u].left;
+         size_t parent = nodes_[u].parent;
+         nodes_[sibling].parent = parent;
+         replace_child(parent, u, sibling);
+         free_.push_back(u);
+
+         if (parent != none())
+         {
+            fix_up(parent);
+         }
+
+         return true;
+      }
+
+      void clear()
+      {
+         nodes_.clear();
+         free_.clear();
+         root_ = none();
+      }
+
+      size_t size() const
+      {
+         return (root_ == none()) ? 0 : nodes_[root_].size;
+      }
+
+      bool empty() const
+      {
+         return root_ == none();
+      }
+
+      // vertices of the hull in counterclockwise order starting from the minimal point,
+      // same as andrew_hull of the points
+      std::vector<point> hull() const
+      {
+         std::vector<point> res, upper;
+
+         if (root_ == none())
+         {
+            return res;
+         }
+
+         chain(root_, LOWER, bound(), bound(), res);
+         chain(root_, UPPER, bound(), bound(), upper);
+
+         for (size_t i = upper.size() - 1; i > 1; --i)
+         {
+            res.push_back(upper[i - 1]);
+         }
+
+         return res;
+      }
+
+      // hull vertex with the maximal projection on d
+      boost::optional<point> extreme(vector_2t<Scalar> const & d) const
+      {
+         point const origin(0, 0);
+         point const normal(-d.y, d.x);
+
+         return descend((d.y >= 0) ? UPPER : LOWER, bound(), bound(), [&origin, &normal] (point const & a, point const & b)
+         {
+            return orientation(origin, normal, a, b) == CG_RIGHT;
+         });
+      }
+
+      // true if q is inside the hull or on its boundary
+      bool contains(point const & q) const
+      {
+         if (root_ == none())
+         {
+            return false;
+         }
+
+         for (chain_t c : {UPPER, LOWER})
+         {
+            std::pair<bound, bound> nb = neighbours(c, q);
+
+            if (!nb.first || !nb.second)
+            {
+               return false;
+            }
+
+            if (*nb.first != q && *nb.second != q && turn(c, *nb.first, *nb.second, q) == CG_LEFT)
+            {
+               return false;
+            }
+         }
+
+         return true;
+      }
+
+      // for q outside of the hull the vertices t1, t2 such that no point is to the right
+      // of q -> t1 and no point is to the left of q -> t2, the farthest among collinear.
+      //
+      // each chain is split by q, a convex chain lying to one side of q changes its
+      // direction around q at most once, so a descent finds the tangent if it is there
+      boost::optional<std::pair<point, point> > tangents(point const & q) const
+      {
+         if (contains(q) || root_ == none())
+         {
+            return boost::none;
+         }
+
+         std::vector<point> candidates;
+
+         for (chain_t c : {UPPER, LOWER})
+         {
+            std::pair<bound, bound> nb = neighbours(c, q);
+            std::vector<std::pair<bound, bound> > views;
+
+            if (nb.first)
+            {
+               candidates.push_back(*nb.first);
+               views.push_back(std::make_pair(bound(), nb.first));
+            }
+
+            if (nb.second)
+            {
+               candidates.push_back(*nb.second);
+               views.push_back(std::make_pair(nb.second, bound()));
+            }
+
+            for (auto const & view : views)
+            {
+               for (orientation_t side : {CG_RIGHT, CG_LEFT})
+               {
+                  bound t = descend(c, view.first, view.second, [&q, side] (point const & a, point const & b)
+                  {
+                     return better(q, a, b, side);
+                  });
+
+                  if (t)
+                  {
+                     candidates.push_back(*t);
+                  }
+               }
+            }
+         }
+
+         candidates.push_back(*descend(UPPER, bound(), bound(), [] (point const &, point const &)
+         {
+            return false;
+         }));
+
+         candidates.push_back(*descend(UPPER, bound(), bound(), [] (point const &, point const &)
+         {
+            return true;
+         }));
+
+         point right = candidates.front(), left = candidates.front();
+
+         for (point const & p : candidates)
+         {
+            if (better(q, right, p, CG_RIGHT))
+            {
+               right = p;
+            }
+
+            if (better(q, left, p, CG_LEFT))
+            {
+               left = p;
+            }
+         }
+
+         return std::make_pair(right, left);
+      }
+
+   private:
+      std::vector<node> nodes_;
+      std::vector<size_t> free_;
+      size_t root_;
+   };
+}
@@ -1,9 +1,17 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include <cg/operations/orientation.h>
 
+#include "akl_toussaint.h"
+
 namespace cg
 {
    template <class BidIter>
@@ -62,6 +70,71 @@ namespace cg
       return ++t;
    }
 
+   // pass as the last argument of graham_hull to sort by precomputed pseudo angles
+   struct pseudo_angle_sort_t {};
+   const pseudo_angle_sort_t pseudo_angle_sort = pseudo_angle_sort_t();
+
+   namespace detail
+   {
+      // increasing with the angle of a - t for a > t, -2 for a == t
+      template <class Point>
+      double pseudo_angle(Point const & t, Point const & a)
+      {
+         double dx = double(a.x) - double(t.x);
+         double dy = double(a.y) - double(t.y);
+         double s = dx + fabs(dy);
+
+         return (s == 0) ? -2 : dy / s;
+      }
+
+      // pseudo angles closer than this may be ordered wrong because of rounding
+      const double PSEUDO_ANGLE_EPS = 32 * std::numeric_limits<double>::epsilon();
+
+      // unsigned integer with the same order as the double
+      inline uint64_t radix_key(double d)
+      {
+         uint64_t bits;
+         memcpy(&bits, &d, sizeof(d));
+         return (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+      }
+
+      // lsd radix sort by the first component, 16 bits per pass
+      inline void radix_sort(std::vector<std::pair<uint64_t, size_t> > & v)
+      {
+         std::vector<std::pair<uint64_t, size_t> > buf(v.size());
+         std::vector<size_t> count(1 << 16);
+
+         for (int shift = 0; shift != 64; shift += 16)
+         {
+            std::fill(count.begin(), count.end(), 0);
+
+            for (auto const & e : v)
+            {
+               ++count[(e.first >> shift) & 0xffff];
+            }
+
+            // all keys have the same digit
+            if (count[(v.front().first >> shift) & 0xffff] == v.size())
+            {
+               continue;
+            }
+
+            for (size_t i = 0, sum = 0; i != count.size(); ++i)
+            {
+               sum += count[i];
+               count[i] = sum - count[i];
+            }
+
+            for (auto const & e : v)
+            {
+               buf[count[(e.first >> shift) & 0xffff]++] = e;
+            }
+
+            v.swap(buf);
+         }
+      }
+   }
+
    template <class RandIter>
    RandIter graham_hull(RandIter p, RandIter q)
    {
@@ -100,4 +173,83 @@ namespace cg
 
       return contour_graham_hull(t, q);
    }
+
+   // same result as graham_hull(p, q). the pseudo angle of every point is computed once,
+   // points are radix sorted by it and only runs of too close pseudo angles are sorted
+   // with the exact predicate
+   template <class RandIter>
+   RandIter graham_hull(RandIter p, RandIter q, pseudo_angle_sort_t)
+   {
+      typedef typename std::iterator_traits<RandIter>::value_type point;
+
+      if (std::distance(p, q) < 256)
+      {
+         return graham_hull(p, q);
+      }
+
+      std::iter_swap(p, std::min_element(p, q));
+
+      point const t = *p;
+      size_t n = std::distance(p, q) - 1;
+
+      std::vector<double> angle(n);
+      std::vector<std::pair<uint64_t, size_t> > keys(n);
+
+      for (size_t i = 0; i != n; ++i)
+      {
+         angle[i] = detail::pseudo_angle(t, p[i + 1]);
+         keys[i] = std::make_pair(detail::radix_key(angle[i]), i);
+      }
+
+      detail::radix_sort(keys);
+
+      std::vector<point> sorted(n);
+
+      for (size_t i = 0; i != n; ++i)
+      {
+         sorted[i] = p[keys[i].second + 1];
+      }
+
+      std::copy(sorted.begin(), sorted.end(), p + 1);
+
+      auto exact = [&t] (point const & a, point const & b)
+      {
+         switch (orientation(t, a, b))
+         {
+         case CG_LEFT:
+            return true;
+
+         case CG_RIGHT:
+            return false;
+
+         default:
+            return a < b;
+         }
+      };
+
+      for (size_t i = 0; i != n; )
+      {
+         size_t j = i + 1;
+
+         while (j != n && angle[keys[j].second] - angle[keys[j - 1].second] <= detail::PSEUDO_ANGLE_EPS)
+         {
+            ++j;
+         }
+
+         if (j - i > 1)
+         {
+            std::sort(p + 1 + i, p + 1 + j, exact);
+         }
+
+         i = j;
+      }
+
+      return contour_graham_hull(p, q);
+   }
+
+   template <class RandIter>
+   RandIter graham_hull(RandIter p, RandIter q, akl_toussaint_prefilter_t)
+   {
+      return graham_hull(p, akl_toussaint_filter(p, q));
+   }
 }
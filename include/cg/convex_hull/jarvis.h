@@ -4,6 +4,8 @@
 
 #include <cg/operations/orientation.h>
 
+#include "akl_toussaint.h"
+
 namespace cg
 {
    template <class RandIter>
@@ -47,4 +49,10 @@ namespace cg
       }
       return remove_points_on_same_line(p, last + 1);
    }
+
+   template <class RandIter>
+   RandIter jarvis_hull(RandIter p, RandIter q, akl_toussaint_prefilter_t)
+   {
+      return jarvis_hull(p, akl_toussaint_filter(p, q));
+   }
 }
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+#include <cg/primitives/point.h>
+#include <cg/primitives/contour.h>
+#include <cg/operations/orientation.h>
+
+namespace cg
+{
+   template <class Scalar>
+   class melkman_hull_2t;
+
+   typedef melkman_hull_2t<double> melkman_hull_2;
+
+   // hull of a simple polyline in O(n) without sorting (melkman).
+   //
+   // vertices are appended one by one, the hull is kept in a deque whose both ends are
+   // the last vertex that left the hull. a vertex inside both edges at the ends is inside
+   // the hull since the polyline does not cross itself
+   template <class Scalar>
+   class melkman_hull_2t
+   {
+      typedef point_2t<Scalar> point;
+
+      // v is to the left of a -> b or on the segment
+      static bool inside(point const & a, point const & b, point const & v)
+      {
+         orientation_t o = orientation(a, b, v);
+         return o == CG_LEFT || (o == CG_COLLINEAR && collinear_are_ordered_along_line(a, v, b));
+      }
+
+      // b is not a strictly convex vertex of a, b, c
+      static bool covered(point const & a, point const & b, point const & c)
+      {
+         orientation_t o = orientation(a, b, c);
+         return o == CG_RIGHT || (o == CG_COLLINEAR && collinear_are_ordered_along_line(a, b, c));
+      }
+
+   public:
+      melkman_hull_2t()
+         : started_(false)
+      {}
+
+      void add_point(point const & v)
+      {
+         if (!started_)
+         {
+            // all vertices so far are on a line, line_ keeps the ends of the segment
+            if (line_.empty())
+            {
+               line_.push_back(v);
+               return;
+            }
+
+            if (line_.size() == 1)
+            {
+               if (v != line_.front())
+               {
+                  line_.push_back(v);
+               }
+
+               return;
+            }
+
+            point a = std::min(line_[0], line_[1]), b = std::max(line_[0], line_[1]);
+            orientation_t o = orientation(a, b, v);
+
+            if (o == CG_COLLINEAR)
+            {
+               line_[0] = std::min(a, v);
+               line_[1] = std::max(b, v);
+               return;
+            }
+
+            if (o == CG_RIGHT)
+            {
+               std::swap(a, b);
+            }
+
+            deque_.assign({v, a, b, v});
+            line_.clear();
+            started_ = true;
+            return;
+         }
+
+         if (inside(deque_[deque_.size() - 2], deque_.back(), v) && inside(deque_.front(), deque_[1], v))
+         {
+            return;
+         }
+
+         while (deque_.size() > 2 && covered(deque_[deque_.size() - 2], deque_.back(), v))
+         {
+            deque_.pop_back();
+         }
+
+         deque_.push_back(v);
+
+         while (deque_.size() > 2 && covered(v, deque_.front(), deque_[1]))
+         {
+            deque_.pop_front();
+         }
+
+         deque_.push_front(v);
+      }
+
+      template <class InputIter>
+      void add_points(InputIter p, InputIter q)
+      {
+         for (; p != q; ++p)
+         {
+            add_point(*p);
+         }
+      }
+
+      void clear()
+      {
+         deque_.clear();
+         line_.clear();
+         started_ = false;
+      }
+
+      // vertices of the hull in counterclockwise order starting from the minimal point,
+      // same as andrew_hull of the vertices
+      template <class OutIter>
+      OutIter hull(OutIter out) const
+      {
+         if (!started_)
+         {
+            std::vector<point> res(line_);
+            std::sort(res.begin(), res.end());
+            return std::copy(res.begin(), res.end(), out);
+         }
+
+         auto last = std::prev(deque_.end());
+         auto first = std::min_element(deque_.begin(), last);
+         out = std::copy(first, last, out);
+         return std::copy(deque_.begin(), first, out);
+      }
+
+      std::vector<point> hull() const
+      {
+         std::vector<point> res;
+         hull(std::back_inserter(res));
+         return res;
+      }
+
+   private:
+      std::deque<point> deque_;
+      std::vector<point> line_;
+      bool started_;
+   };
+
+   // hull of the simple polyline [p, q) written to out as by andrew_hull
+   template <class BidIter, class OutIter>
+   OutIter melkman_hull(BidIter p, BidIter q, OutIter out)
+   {
+      typedef typename std::iterator_traits<BidIter>::value_type point;
+
+      melkman_hull_2t<typename point::scalar_type> res;
+      res.add_points(p, q);
+      return res.hull(out);
+   }
+
+   // hull of a simple polygon
+   template <class Scalar>
+   contour_2t<Scalar> melkman_hull(contour_2t<Scalar> const & c)
+   {
+      std::vector<point_2t<Scalar> > res;
+      melkman_hull(c.begin(), c.end(), std::back_inserter(res));
+      return contour_2t<Scalar>(res);
+   }
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <cg/operations/orientation.h>
+
+#include "andrew.h"
+#include "chan.h"
+#include "parallel_quick_hull.h"
+
+namespace cg
+{
+   namespace detail
+   {
+      // vertices of a hull given in andrew_hull order, sorted lexicographically
+      template <class RandIter>
+      std::vector<RandIter> sorted_hull(std::vector<RandIter> const & h)
+      {
+         size_t top = 0;
+
+         for (size_t i = 1; i != h.size(); ++i)
+         {
+            if (*h[top] < *h[i])
+            {
+               top = i;
+            }
+         }
+
+         std::vector<RandIter> res(h.size());
+         std::merge(h.begin(), h.begin() + top + 1, h.rbegin(), h.rend() - top - 1, res.begin(),
+                    [] (RandIter a, RandIter b) { return *a < *b; });
+         return res;
+      }
+
+      // hull of lexicographically sorted points in andrew_hull order, linear time
+      template <class RandIter>
+      std::vector<RandIter> sorted_points_hull(std::vector<RandIter> pts)
+      {
+         pts.erase(std::unique(pts.begin(), pts.end(), [] (RandIter x, RandIter y) { return *x == *y; }), pts.end());
+
+         if (pts.size() < 3)
+         {
+            return pts;
+         }
+
+         // monotone chain, lower chain then upper chain
+         std::vector<RandIter> res;
+
+         for (int pass = 0; pass != 2; ++pass)
+         {
+            size_t start = res.size();
+
+            for (RandIter it : pts)
+            {
+               while (res.size() >= start + 2 && orientation(*res[res.size() - 2], *res.back(), *it) != CG_LEFT)
+               {
+                  res.pop_back();
+               }
+
+               res.push_back(it);
+            }
+
+            res.pop_back();
+            std::reverse(pts.begin(), pts.end());
+         }
+
+         return res;
+      }
+
+      // hull of the union of two hulls given in andrew_hull order, linear time
+      template <class RandIter>
+      std::vector<RandIter> merge_hulls(std::vector<RandIter> const & a, std::vector<RandIter> const & b)
+      {
+         std::vector<RandIter> sa = sorted_hull(a), sb = sorted_hull(b);
+         std::vector<RandIter> pts(sa.size() + sb.size());
+         std::merge(sa.begin(), sa.end(), sb.begin(), sb.end(), pts.begin(),
+                    [] (RandIter x, RandIter y) { return *x < *y; });
+
+         return sorted_points_hull(pts);
+      }
+   }
+
+   // map-reduce hull: hull(begin, end) runs on a chunk per thread, chunk hulls are merged
+   // pairwise in linear time. hull is any function with the contract of andrew_hull, the
+   // result is in andrew_hull order whatever the backend is
+   template <class RanIter, class Hull>
+   typename std::enable_if<!std::is_integral<Hull>::value, RanIter>::type
+      parallel_hull(RanIter begin, RanIter end, Hull hull, size_t threads = std::thread::hardware_concurrency())
+   {
+      if (threads < 2 || size_t(end - begin) < detail::PARALLEL_HULL_CUTOFF)
+      {
+         threads = 1;
+      }
+
+      auto chunks = detail::split(begin, end, threads);
+      std::vector<std::future<std::vector<RanIter> > > parts;
+
+      for (auto const & r : chunks)
+      {
+         parts.push_back(std::async(threads == 1 ? std::launch::deferred : std::launch::async, [r, hull] ()
+         {
+            std::vector<RanIter> res;
+
+            for (RanIter it = r.first, e = hull(r.first, r.second); it != e; ++it)
+            {
+               res.push_back(it);
+            }
+
+            // backends differ in the starting vertex and in collinear vertices
+            std::sort(res.begin(), res.end(), [] (RanIter a, RanIter b) { return *a < *b; });
+            return detail::sorted_points_hull(res);
+         }));
+      }
+
+      std::vector<std::vector<RanIter> > hulls;
+
+      for (auto & part : parts)
+      {
+         hulls.push_back(part.get());
+      }
+
+      while (hulls.size() > 1)
+      {
+         std::vector<std::future<std::vector<RanIter> > > merged;
+
+         for (size_t i = 0; i + 1 < hulls.size(); i += 2)
+         {
+            merged.push_back(std::async(std::launch::async, [&hulls, i] ()
+            {
+               return detail::merge_hulls(hulls[i], hulls[i + 1]);
+            }));
+         }
+
+         std::vector<std::vector<RanIter> > next;
+
+         for (auto & m : merged)
+         {
+            next.push_back(m.get());
+         }
+
+         if (hulls.size() % 2)
+         {
+            next.push_back(hulls.back());
+         }
+
+         hulls.swap(next);
+      }
+
+      if (hulls.empty())
+      {
+         return begin;
+      }
+
+      detail::move_to_front(begin, hulls.front());
+      return begin + hulls.front().size();
+   }
+
+   template <class RanIter>
+   RanIter parallel_hull(RanIter begin, RanIter end, size_t threads = std::thread::hardware_concurrency())
+   {
+      return parallel_hull(begin, end, [] (RanIter p, RanIter q)
+      {
+         return andrew_hull(p, q);
+      }, threads);
+   }
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cg/convex_hull/quick_hull.h>
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+#include <utility>
+
+namespace cg
+{
+   namespace detail
+   {
+      // ranges shorter than this are processed by the sequential algorithm
+      const size_t PARALLEL_HULL_CUTOFF = 1 << 15;
+
+      template <class RanIter>
+      std::vector<std::pair<RanIter, RanIter> > split(RanIter begin, RanIter end, size_t parts)
+      {
+         std::vector<std::pair<RanIter, RanIter> > res;
+         size_t chunk = (end - begin + parts - 1) / parts;
+
+         for (RanIter s = begin; s != end; )
+         {
+            RanIter e = (size_t(end - s) > chunk) ? s + chunk : end;
+            res.push_back(std::make_pair(s, e));
+            s = e;
+         }
+
+         return res;
+      }
+
+      // same result as std::max_element(begin, end, less)
+      template <class RanIter, class Less>
+      RanIter parallel_max_element(RanIter begin, RanIter end, Less less, size_t threads)
+      {
+         if (threads < 2 || size_t(end - begin) < PARALLEL_HULL_CUTOFF)
+         {
+            return std::max_element(begin, end, less);
+         }
+
+         std::vector<std::future<RanIter> > parts;
+
+         for (auto const & r : split(begin, end, threads))
+         {
+            parts.push_back(std::async(std::launch::async, [r, less] ()
+            {
+               return std::max_element(r.first, r.second, less);
+            }));
+         }
+
+         RanIter res = parts.front().get();
+
+         for (size_t i = 1; i != parts.size(); ++i)
+         {
+            RanIter candidate = parts[i].get();
+
+            if (less(*res, *candidate))
+            {
+               res = candidate;
+            }
+         }
+
+         return res;
+      }
+
+      // chunks are partitioned concurrently, then only the misplaced elements are swapped
+      template <class RanIter, class Pred>
+      RanIter parallel_partition(RanIter begin, RanIter end, Pred pred, size_t threads)
+      {
+         if (threads < 2 || size_t(end - begin) < PARALLEL_HULL_CUTOFF)
+         {
+            return std::partition(begin, end, pred);
+         }
+
+         auto chunks = split(begin, end, threads);
+         std::vector<std::future<RanIter> > parts;
+
+         for (auto const & r : chunks)
+         {
+            parts.push_back(std::async(std::launch::async, [r, pred] ()
+            {
+               return std::partition(r.first, r.second, pred);
+            }));
+         }
+
+         std::vector<RanIter> mids;
+         size_t count = 0;
+
+         for (size_t i = 0; i != chunks.size(); ++i)
+         {
+            mids.push_back(parts[i].get());
+            count += mids[i] - chunks[i].first;
+         }
+
+         RanIter bound = begin + count;
+         std::vector<std::pair<RanIter, RanIter> > wrong_false, wrong_true;
+
+         for (size_t i = 0; i != chunks.size(); ++i)
+         {
+            if (mids[i] < bound)
+            {
+               wrong_false.push_back(std::make_pair(mids[i], std::min(chunks[i].second, bound)));
+            }
+
+            if (mids[i] > bound)
+            {
+               wrong_true.push_back(std::make_pair(std::max(chunks[i].first, bound), mids[i]));
+            }
+         }
+
+         auto t = wrong_true.begin();
+         RanIter tt = (t != wrong_true.end()) ? t->first : end;
+
+         for (auto const & f : wrong_false)
+         {
+            for (RanIter ff = f.first; ff != f.second; ++ff)
+            {
+               if (tt == t->second)
+               {
+                  tt = (++t)->first;
+               }
+
+               std::iter_swap(ff, tt++);
+            }
+         }
+
+         return bound;
+      }
+
+      template <class RanIter>
+      RanIter parallel_build_part(RanIter begin, RanIter end, point_2 last_point, size_t threads)
+      {
+         if (threads < 2 || size_t(end - begin) < PARALLEL_HULL_CUTOFF)
+         {
+            return build_part(begin, end, last_point);
+         }
+
+         point_2 const start = *begin;
+
+         RanIter highest_point_iter = parallel_max_element(begin, end, [start, last_point] (point_2 const & largest, point_2 const & first)
+         {
+            return pred(largest, first, start, last_point) == CG_RIGHT;
+         }, threads);
+
+         point_2 highest_point = *highest_point_iter;
+
+         if (orientation(start, last_point, highest_point) == CG_COLLINEAR)
+         {
+            return begin + 1;
+         }
+
+         std::iter_swap(begin + 1, highest_point_iter);
+
+         RanIter first = parallel_partition(begin + 2, end, [start, highest_point] (point_2 const & point)
+         {
+            return orientation(start, highest_point, point) == CG_RIGHT;
+         }, threads);
+
+         RanIter second = parallel_partition(first, end, [highest_point, last_point] (point_2 const & point)
+         {
+            return orientation(highest_point, last_point, point) == CG_RIGHT;
+         }, threads);
+
+         std::iter_swap(begin + 1, first - 1);
+
+         size_t left_threads = std::max<size_t>(1, threads * (first - begin) / (second - begin));
+         left_threads = std::min(left_threads, threads - 1);
+
+         auto left = std::async(std::launch::async, [begin, first, highest_point, left_threads] ()
+         {
+            return parallel_build_part(begin, first - 1, highest_point, left_threads);
+         });
+
+         RanIter second_end = parallel_build_part(first - 1, second, last_point, threads - left_threads);
+         RanIter first_end = left.get();
+         return swap_ranges(first - 1, second_end, first_end);
+      }
+   }
+
+   // same contract as quick_hull: hull is moved to the beginning of the range
+   // and the end of the hull is returned
+   template <class RanIter>
+   RanIter parallel_quick_hull(RanIter begin, RanIter end, size_t threads = std::thread::hardware_concurrency())
+   {
+      if (threads < 2 || size_t(end - begin) < detail::PARALLEL_HULL_CUTOFF)
+      {
+         return quick_hull(begin, end);
+      }
+
+      std::iter_swap(begin, detail::parallel_max_element(begin, end, std::greater<point_2>(), threads));
+      std::iter_swap(end - 1, detail::parallel_max_element(begin, end, std::less<point_2>(), threads));
+
+      if (*begin == *(end - 1))
+      {
+         return ++begin;
+      }
+
+      point_2 const left = *begin, right = *(end - 1);
+
+      RanIter bound = detail::parallel_partition(begin + 1, end - 1, [left, right] (point_2 const & a)
+      {
+         return orientation(left, right, a) == CG_RIGHT;
+      }, threads);
+
+      std::iter_swap(end - 1, bound);
+
+      auto lower = std::async(std::launch::async, [begin, bound, right, threads] ()
+      {
+         return detail::parallel_build_part(begin, bound, right, threads / 2);
+      });
+
+      RanIter second = detail::parallel_build_part(bound, end, left, threads - threads / 2);
+      RanIter first = lower.get();
+      return swap_ranges(bound, second, first);
+   }
+}
@@ -3,6 +3,7 @@
 #include <cg/primitives/point.h>
 #include <cg/primitives/vector.h>
 #include <cg/operations/orientation.h>
+#include <cg/convex_hull/akl_toussaint.h>
 #include <algorithm>
 #include <utility>
 #include <functional>
@@ -155,4 +156,10 @@ namespace cg
         RanIter second = build_part(bound, end, *begin);
         return swap_ranges(bound, second, first);
     }
+
+    template <class RanIter>
+    RanIter quick_hull(RanIter begin, RanIter end, akl_toussaint_prefilter_t)
+    {
+        return quick_hull(begin, akl_toussaint_filter(begin, end));
+    }
 }
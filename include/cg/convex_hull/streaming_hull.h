@@ -0,0 +1,150 @@
+#pragma once
+
+#include <iterator>
+#include <set>
+#include <vector>
+
+#include <cg/primitives/point.h>
+#include <cg/operations/orientation.h>
+
+namespace cg
+{
+   template <class Scalar>
+   class streaming_hull_2t;
+
+   typedef streaming_hull_2t<double> streaming_hull_2;
+
+   // online convex hull of a stream of points, keeps only the current hull vertices.
+   //
+   // the upper and lower chains are ordered sets, a point inside the hull is rejected
+   // after a lookup, otherwise it is added and the vertices it covers are removed.
+   // insert is O(log h) amortized, memory is O(h)
+   template <class Scalar>
+   class streaming_hull_2t
+   {
+      typedef point_2t<Scalar> point;
+      typedef std::set<point> chain_t;
+
+      // side is the turn of the chain seen from the outside: CG_RIGHT for the upper chain
+      static bool insert(chain_t & chain, point const & p, orientation_t side)
+      {
+         typename chain_t::iterator next = chain.lower_bound(p);
+
+         if (next != chain.end() && *next == p)
+         {
+            return false;
+         }
+
+         if (next != chain.begin() && next != chain.end()
+             && orientation(*std::prev(next), *next, p) != orientation_t(-side))
+         {
+            return false;
+         }
+
+         typename chain_t::iterator it = chain.insert(next, p);
+
+         while (it != chain.begin() && std::prev(it) != chain.begin())
+         {
+            typename chain_t::iterator a = std::prev(it);
+
+            if (orientation(*std::prev(a), *a, p) == side)
+            {
+               break;
+            }
+
+            chain.erase(a);
+         }
+
+         while (next != chain.end() && std::next(next) != chain.end())
+         {
+            if (orientation(p, *next, *std::next(next)) == side)
+            {
+               break;
+            }
+
+            next = chain.erase(next);
+         }
+
+         return true;
+      }
+
+   public:
+      // returns true if p is a vertex of the new hull
+      bool insert(point const & p)
+      {
+         bool upper = insert(upper_, p, CG_RIGHT);
+         bool lower = insert(lower_, p, CG_LEFT);
+         return upper || lower;
+      }
+
+      template <class InputIter>
+      void insert(InputIter p, InputIter q)
+      {
+         for (; p != q; ++p)
+         {
+            insert(*p);
+         }
+      }
+
+      // after merge the hull is the hull of the points of both streams
+      void merge(streaming_hull_2t const & other)
+      {
+         insert(other.upper_.begin(), other.upper_.end());
+         insert(other.lower_.begin(), other.lower_.end());
+      }
+
+      void clear()
+      {
+         upper_.clear();
+         lower_.clear();
+      }
+
+      bool empty() const
+      {
+         return lower_.empty();
+      }
+
+      // number of hull vertices
+      size_t size() const
+      {
+         size_t res = upper_.size() + lower_.size();
+         return (res > 2) ? res - 2 : res / 2;
+      }
+
+      // vertices of the hull in counterclockwise order starting from the minimal point,
+      // same as andrew_hull of the stream
+      template <class OutIter>
+      OutIter hull(OutIter out) const
+      {
+         out = std::copy(lower_.begin(), lower_.end(), out);
+
+         if (upper_.size() > 2)
+         {
+            out = std::copy(std::next(upper_.rbegin()), std::prev(upper_.rend()), out);
+         }
+
+         return out;
+      }
+
+      std::vector<point> hull() const
+      {
+         std::vector<point> res;
+         hull(std::back_inserter(res));
+         return res;
+      }
+
+   private:
+      chain_t upper_, lower_;
+   };
+
+   // single pass hull of an input range, written to out as by andrew_hull
+   template <class InputIter, class OutIter>
+   OutIter streaming_hull(InputIter p, InputIter q, OutIter out)
+   {
+      typedef typename std::iterator_traits<InputIter>::value_type point;
+
+      streaming_hull_2t<typename point::scalar_type> res;
+      res.insert(p, q);
+      return res.hull(out);
+   }
+}
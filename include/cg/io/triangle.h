@@ -14,7 +14,7 @@ namespace cg
    }
 
    template <class Scalar>
-   std::ostream & operator << (std::ostream & out, rectangle_2t<Scalar> const & tr)
+   std::ostream & operator << (std::ostream & out, triangle_2t<Scalar> const & tr)
    {
       out << "(" << tr[0] << ", " << tr[1] << ", " << tr[2] << ")";
       return out;
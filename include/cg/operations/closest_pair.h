@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cg/primitives/point.h>
+#include <cg/operations/compare_dist.h>
+#include <cg/convex_hull/parallel_quick_hull.h>
+
+namespace cg
+{
+   namespace detail
+   {
+      template <class RandIter>
+      struct closest_pair_state
+      {
+         std::pair<RandIter, RandIter> best;
+         bool found;
+
+         // no pair closer than the best one is farther apart than this along an axis
+         double reach() const
+         {
+            if (!found)
+            {
+               return std::numeric_limits<double>::infinity();
+            }
+
+            double dx = best.first->x - best.second->x, dy = best.first->y - best.second->y;
+            return std::sqrt(dx * dx + dy * dy) * (1 + 8 * std::numeric_limits<double>::epsilon());
+         }
+
+         void update(RandIter a, RandIter b)
+         {
+            if (!found || compare_dist(*a, *b, *best.first, *best.second))
+            {
+               best = std::make_pair(a, b);
+               found = true;
+            }
+         }
+      };
+
+      template <class RandIter>
+      bool less_x(RandIter a, RandIter b)
+      {
+         return *a < *b;
+      }
+
+      // sweep over [from, to) of pts sorted by x, the points within the current distance
+      // to the left of the sweep line are kept ordered by y
+      template <class RandIter>
+      void closest_pair_sweep(std::vector<RandIter> const & pts, size_t from, size_t to, closest_pair_state<RandIter> & state)
+      {
+         typedef std::pair<double, size_t> key_t;
+         std::set<key_t> active;
+         size_t left = from;
+
+         for (size_t i = from; i != to; ++i)
+         {
+            RandIter p = pts[i];
+            double d = state.reach();
+
+            for (; left != i && pts[left]->x < p->x - d; ++left)
+            {
+               active.erase(key_t(pts[left]->y, left));
+            }
+
+            for (auto it = active.lower_bound(key_t(p->y - d, 0)); it != active.end() && it->first <= p->y + d; ++it)
+            {
+               state.update(pts[it->second], p);
+            }
+
+            if (state.found && *state.best.first == *state.best.second)
+            {
+               return;
+            }
+
+            active.insert(key_t(p->y, i));
+         }
+      }
+
+      template <class RandIter>
+      std::vector<RandIter> sorted_by_x(RandIter p, RandIter q)
+      {
+         std::vector<RandIter> res;
+         res.reserve(q - p);
+
+         for (RandIter it = p; it != q; ++it)
+         {
+            res.push_back(it);
+         }
+
+         std::sort(res.begin(), res.end(), less_x<RandIter>);
+         return res;
+      }
+   }
+
+   // closest pair of points of [p, q) (as a pair of iterators in it) by a sweep line,
+   // O(n log n). distances are compared with the exact compare_dist. (q, q) if there are
+   // less than two points
+   template <class RandIter>
+   std::pair<RandIter, RandIter> closest_pair(RandIter p, RandIter q)
+   {
+      std::vector<RandIter> pts = detail::sorted_by_x(p, q);
+
+      detail::closest_pair_state<RandIter> state = {std::make_pair(q, q), false};
+      detail::closest_pair_sweep(pts, 0, pts.size(), state);
+      return state.best;
+   }
+
+   // closest_pair on several threads: the points sorted by x are split into strips, each
+   // strip is swept on its own thread, then the bands of the current distance around the
+   // borders of the strips are swept for pairs that cross them
+   template <class RandIter>
+   std::pair<RandIter, RandIter> parallel_closest_pair(RandIter p, RandIter q, size_t threads = std::thread::hardware_concurrency())
+   {
+      typedef detail::closest_pair_state<RandIter> state_t;
+
+      if (threads < 2 || size_t(q - p) < detail::PARALLEL_HULL_CUTOFF)
+      {
+         return closest_pair(p, q);
+      }
+
+      std::vector<RandIter> pts;
+      pts.reserve(q - p);
+
+      for (RandIter it = p; it != q; ++it)
+      {
+         pts.push_back(it);
+      }
+
+      // chunks are sorted in parallel and merged pairwise
+      auto chunks = detail::split(pts.begin(), pts.end(), threads);
+      std::vector<std::future<void> > sorts;
+
+      for (auto const & r : chunks)
+      {
+         sorts.push_back(std::async(std::launch::async, [r] ()
+         {
+            std::sort(r.first, r.second, detail::less_x<RandIter>);
+         }));
+      }
+
+      for (auto & s : sorts)
+      {
+         s.get();
+      }
+
+      for (size_t step = 1; step < chunks.size(); step *= 2)
+      {
+         std::vector<std::future<void> > merges;
+
+         for (size_t i = 0; i + step < chunks.size(); i += 2 * step)
+         {
+            auto first = chunks[i].first, middle = chunks[i + step].first;
+            auto last = chunks[std::min(i + 2 * step, chunks.size()) - 1].second;
+
+            merges.push_back(std::async(std::launch::async, [first, middle, last] ()
+            {
+               std::inplace_merge(first, middle, last, detail::less_x<RandIter>);
+            }));
+         }
+
+         for (auto & m : merges)
+         {
+            m.get();
+         }
+      }
+
+      std::vector<size_t> borders;
+
+      for (auto const & r : chunks)
+      {
+         borders.push_back(r.first - pts.begin());
+      }
+
+      borders.push_back(pts.size());
+
+      std::vector<std::future<state_t> > parts;
+
+      for (size_t k = 0; k + 1 != borders.size(); ++k)
+      {
+         size_t from = borders[k], to = borders[k + 1];
+
+         parts.push_back(std::async(std::launch::async, [&pts, from, to, q] ()
+         {
+            state_t res = {std::make_pair(q, q), false};
+            detail::closest_pair_sweep(pts, from, to, res);
+            return res;
+         }));
+      }
+
+      state_t state = {std::make_pair(q, q), false};
+
+      for (auto & part : parts)
+      {
+         state_t s = part.get();
+
+         if (s.found)
+         {
+            state.update(s.best.first, s.best.second);
+         }
+      }
+
+      for (size_t k = 1; k + 1 < borders.size(); ++k)
+      {
+         double d = state.reach();
+         double lo = pts[borders[k]]->x - d, hi = pts[borders[k] - 1]->x + d;
+
+         auto from = std::partition_point(pts.begin(), pts.begin() + borders[k], [lo] (RandIter it) { return it->x < lo; });
+         auto to = std::partition_point(pts.begin() + borders[k], pts.end(), [hi] (RandIter it) { return it->x <= hi; });
+
+         detail::closest_pair_sweep(pts, from - pts.begin(), to - pts.begin(), state);
+      }
+
+      return state.best;
+   }
+
+   // all pairs (i, j), i < j, of points of [p, q) closer than r, indices are relative to p.
+   // points are bucketed in a grid of cells of side r, a pair is checked with compare_dist
+   // only if its cells are neighbours. O(n log n + number of checked pairs)
+   template <class RandIter, class OutIter>
+   OutIter pairs_closer_than(RandIter p, RandIter q, double r, OutIter out)
+   {
+      typedef typename std::iterator_traits<RandIter>::value_type point;
+      typedef std::pair<long long, long long> cell_t;
+
+      size_t n = q - p;
+
+      if (n < 2 || !(r > 0))
+      {
+         return out;
+      }
+
+      point origin = *std::min_element(p, q, [] (point const & a, point const & b) { return a.x < b.x; });
+      origin.y = std::min_element(p, q, [] (point const & a, point const & b) { return a.y < b.y; })->y;
+
+      // slightly wider cells: a pair closer than r stays in neighbouring cells whatever
+      // the rounding of the cell computation is
+      double side = r * (1 + 1e-6);
+      point zero(0, 0), unit(r, 0);
+
+      // cells farther than the range of long long (with room for the neighbours) are
+      // merged into the last one, it only adds checked pairs
+      double const last_cell = 1ll << 62;
+      auto cell = [&] (double d)
+      {
+         return (long long)std::min(std::floor(d / side), last_cell);
+      };
+
+      std::vector<std::pair<cell_t, size_t> > cells(n);
+
+      for (size_t i = 0; i != n; ++i)
+      {
+         cells[i] = std::make_pair(cell_t(cell(p[i].x - origin.x), cell(p[i].y - origin.y)), i);
+      }
+
+      std::sort(cells.begin(), cells.end());
+
+      auto check = [&] (size_t i, size_t j)
+      {
+         if (compare_dist(p[i], p[j], zero, unit))
+         {
+            *out++ = std::make_pair(std::min(i, j), std::max(i, j));
+         }
+      };
+
+      for (size_t s = 0; s != n; )
+      {
+         cell_t c = cells[s].first;
+         size_t e = s;
+
+         while (e != n && cells[e].first == c)
+         {
+            ++e;
+         }
+
+         for (size_t a = s; a != e; ++a)
+         {
+            for (size_t b = a + 1; b != e; ++b)
+            {
+               check(cells[a].second, cells[b].second);
+            }
+         }
+
+         // half of the neighbourhood, every pair of cells is visited once
+         cell_t const neighbours[4] =
+         {
+            cell_t(c.first, c.second + 1),
+            cell_t(c.first + 1, c.second - 1),
+            cell_t(c.first + 1, c.second),
+            cell_t(c.first + 1, c.second + 1),
+         };
+
+         for (cell_t const & nb : neighbours)
+         {
+            auto range = std::equal_range(cells.begin() + e, cells.end(), std::make_pair(nb, size_t(0)),
+                                          [] (std::pair<cell_t, size_t> const & x, std::pair<cell_t, size_t> const & y)
+                                          {
+                                             return x.first < y.first;
+                                          });
+
+            for (size_t a = s; a != e; ++a)
+            {
+               for (auto it = range.first; it != range.second; ++it)
+               {
+                  check(cells[a].second, it->second);
+               }
+            }
+         }
+
+         s = e;
+      }
+
+      return out;
+   }
+}
@@ -37,28 +37,24 @@ namespace cg
    {
       boost::optional<bool> operator() (point_2 const & a, point_2 const & b, point_2 const & c, point_2 const & d) const
       {
-         return boost::none; // :(
-
-         double a00 = (a.x - d.x);
-         double a01 = ((a.y) - d.y);
-         double a02 = ((a.x) * a.x - (d.x) * d.x) + ((a.y) * a.y - (d.y) * d.y);
-         double a10 = ((b.x) - d.x);
-         double a11 = ((b.y) - d.y);
-         double a12 = ((b.x) * b.x - (d.x) * d.x) + ((b.y) * b.y - (d.y) * d.y);
-         double a20 = ((c.x) - d.x);
-         double a21 = ((c.y) - d.y);
-         double a22 = ((c.x) * c.x - (d.x) * d.x) + ((c.y) * c.y - (d.y) * d.y);
-         double m1 = a00*a11*a22, m2 = a01*a12*a20, m3 = a02*a10*a21, m4=a20*a11*a02, m5=a21*a12*a00, m6=a01*a10*a22;
-         double det =  m1+m2+m3-m4-m5-m6;
-         double sum = fabs(m1)+fabs(m2)+fabs(m3)+fabs(m4)+fabs(m5)+fabs(m6);
+         // the lifted determinant relative to d with the error bound of shewchuk's incircle
+         double adx = a.x - d.x, ady = a.y - d.y;
+         double bdx = b.x - d.x, bdy = b.y - d.y;
+         double cdx = c.x - d.x, cdy = c.y - d.y;
+
+         double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+         double cdxady = cdx * ady, adxcdy = adx * cdy;
+         double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+         double alift = adx * adx + ady * ady;
+         double blift = bdx * bdx + bdy * bdy;
+         double clift = cdx * cdx + cdy * cdy;
+
+         double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+         double sum = (fabs(bdxcdy) + fabs(cdxbdy)) * alift
+                    + (fabs(cdxady) + fabs(adxcdy)) * blift
+                    + (fabs(adxbdy) + fabs(bdxady)) * clift;
          double eps = sum * 16 * std::numeric_limits<double>::epsilon();
-         /*std::cerr << "-------------------" << std::endl;
-         std::cerr << a00 << " " << a01 << " " << a02 << std::endl
-                   << a10 << " " << a11 << " " << a12 << std::endl
-                   << a20 << " " << a21 << " " << a22 << std::endl;
-         std::cerr << "det = " << det << "; eps = " << eps << std::endl;
-         std::cerr << *in_circle_r()(a, b, c, d) << std::endl;
-         std::cerr << "-------------------" << std::endl << std::endl;*/
 
          if (det > eps)
          {
@@ -0,0 +1,404 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <cg/primitives/contour.h>
+#include <cg/primitives/point.h>
+#include <cg/operations/orientation.h>
+#include <cg/operations/contains/contour_point.h>
+#include <cg/convex_hull/parallel_quick_hull.h>
+
+namespace cg
+{
+   template <class Scalar>
+   class trapezoidal_map_2t;
+
+   typedef trapezoidal_map_2t<double> trapezoidal_map_2;
+
+   // point location index of a simple contour: the randomized incremental trapezoidal
+   // map with its search structure (de berg et al., chapter 6). expected O(n log n) to
+   // build, O(n) size and O(log n) per query. points are compared lexicographically,
+   // which is a symbolic shear: equal x coordinates and vertical edges need no care.
+   //
+   // contains gives the same answer as contains(contour, point), the boundary is inside
+   template <class Scalar>
+   class trapezoidal_map_2t
+   {
+      typedef point_2t<Scalar> point;
+
+      static const size_t none = size_t(-1);
+
+      // l < r
+      struct segment
+      {
+         point l, r;
+         // the interior of the contour is above the segment
+         bool inside_above;
+      };
+
+      // between the segments top and bottom (none if unbounded) and the vertical lines
+      // through leftp and rightp (none if unbounded). ul and ll are the left neighbours
+      // touching the left side above and below leftp, ur and lr the right ones
+      struct trapezoid
+      {
+         size_t top, bottom;
+         size_t leftp, rightp;
+         size_t ul, ll, ur, lr;
+         size_t node;
+      };
+
+      enum node_kind { X_NODE, Y_NODE, LEAF };
+
+      // x: left and right of a point, y: above and below a segment
+      struct node
+      {
+         node_kind kind;
+         size_t index;
+         size_t left, right;
+      };
+
+      size_t new_node(node_kind kind, size_t index, size_t left = none, size_t right = none)
+      {
+         node nd = {kind, index, left, right};
+         nodes_.push_back(nd);
+         return nodes_.size() - 1;
+      }
+
+      size_t new_trapezoid(size_t top, size_t bottom, size_t leftp, size_t rightp)
+      {
+         trapezoid t = {top, bottom, leftp, rightp, none, none, none, none, none};
+         traps_.push_back(t);
+         traps_.back().node = new_node(LEAF, traps_.size() - 1);
+         return traps_.size() - 1;
+      }
+
+      // the neighbour t pointing to old on the left or right side points to now instead
+      void relink(size_t t, size_t old, size_t now, bool left_side)
+      {
+         if (t == none)
+         {
+            return;
+         }
+
+         size_t & a = left_side ? traps_[t].ul : traps_[t].ur;
+         size_t & b = left_side ? traps_[t].ll : traps_[t].lr;
+
+         if (a == old)
+         {
+            a = now;
+         }
+
+         if (b == old)
+         {
+            b = now;
+         }
+      }
+
+      // the trapezoid where the segment s starts, just above or below the segments with
+      // the same left end
+      size_t locate(segment const & s) const
+      {
+         size_t nd = 0;
+
+         while (nodes_[nd].kind != LEAF)
+         {
+            node const & n = nodes_[nd];
+
+            if (n.kind == X_NODE)
+            {
+               nd = (s.l < points_[n.index]) ? n.left : n.right;
+            }
+            else
+            {
+               segment const & t = segs_[n.index];
+               orientation_t o = orientation(t.l, t.r, s.l);
+
+               if (o == CG_COLLINEAR)
+               {
+                  o = orientation(t.l, t.r, s.r);
+               }
+
+               nd = (o == CG_LEFT) ? n.left : n.right;
+            }
+         }
+
+         return nodes_[nd].index;
+      }
+
+      void insert(size_t si)
+      {
+         segment const & s = segs_[si];
+         size_t l = std::lower_bound(points_.begin(), points_.end(), s.l) - points_.begin();
+         size_t r = std::lower_bound(points_.begin(), points_.end(), s.r) - points_.begin();
+
+         // trapezoids crossed by s from left to right
+         std::vector<size_t> & crossed = crossed_;
+         crossed.assign(1, locate(s));
+
+         while (traps_[crossed.back()].rightp != none && points_[traps_[crossed.back()].rightp] < s.r)
+         {
+            trapezoid const & d = traps_[crossed.back()];
+            bool above = orientation(s.l, s.r, points_[d.rightp]) == CG_LEFT;
+            crossed.push_back(above ? d.lr : d.ur);
+         }
+
+         trapezoid const first = traps_[crossed.front()];
+         trapezoid const last = traps_[crossed.back()];
+
+         bool has_left = first.leftp == none || points_[first.leftp] < s.l;
+         bool has_right = last.rightp == none || s.r < points_[last.rightp];
+
+         size_t left = has_left ? new_trapezoid(first.top, first.bottom, first.leftp, l) : none;
+         size_t up = new_trapezoid(first.top, si, l, none);
+         size_t down = new_trapezoid(si, first.bottom, l, none);
+
+         if (has_left)
+         {
+            traps_[left].ul = first.ul;
+            traps_[left].ll = first.ll;
+            traps_[left].ur = up;
+            traps_[left].lr = down;
+            relink(first.ul, crossed.front(), left, false);
+            relink(first.ll, crossed.front(), left, false);
+            traps_[up].ul = left;
+            traps_[down].ll = left;
+         }
+         else
+         {
+            traps_[up].ul = first.ul;
+            traps_[down].ll = first.ll;
+            relink(first.ul, crossed.front(), up, false);
+            relink(first.ll, crossed.front(), down, false);
+         }
+
+         // the old trapezoids become y nodes over the new ones
+         std::vector<std::pair<size_t, size_t> > & split = split_;
+         split.assign(1, std::make_pair(up, down));
+
+         for (size_t j = 0; j + 1 < crossed.size(); ++j)
+         {
+            trapezoid const d = traps_[crossed[j]];
+            trapezoid const e = traps_[crossed[j + 1]];
+
+            if (orientation(s.l, s.r, points_[d.rightp]) == CG_LEFT)
+            {
+               // the side above s stays
+               size_t next = new_trapezoid(e.top, si, d.rightp, none);
+               traps_[up].rightp = d.rightp;
+               traps_[up].ur = d.ur;
+               traps_[up].lr = next;
+               relink(d.ur, crossed[j], up, true);
+               traps_[next].ul = e.ul;
+               traps_[next].ll = up;
+               relink(e.ul, crossed[j + 1], next, false);
+               up = next;
+            }
+            else
+            {
+               size_t next = new_trapezoid(si, e.bottom, d.rightp, none);
+               traps_[down].rightp = d.rightp;
+               traps_[down].lr = d.lr;
+               traps_[down].ur = next;
+               relink(d.lr, crossed[j], down, true);
+               traps_[next].ll = e.ll;
+               traps_[next].ul = down;
+               relink(e.ll, crossed[j + 1], next, false);
+               down = next;
+            }
+
+            split.push_back(std::make_pair(up, down));
+         }
+
+         size_t right = has_right ? new_trapezoid(last.top, last.bottom, r, last.rightp) : none;
+         traps_[up].rightp = r;
+         traps_[down].rightp = r;
+
+         if (has_right)
+         {
+            traps_[right].ur = last.ur;
+            traps_[right].lr = last.lr;
+            traps_[right].ul = up;
+            traps_[right].ll = down;
+            relink(last.ur, crossed.back(), right, true);
+            relink(last.lr, crossed.back(), right, true);
+            traps_[up].ur = right;
+            traps_[down].lr = right;
+         }
+         else
+         {
+            traps_[up].ur = last.ur;
+            traps_[down].lr = last.lr;
+            relink(last.ur, crossed.back(), up, true);
+            relink(last.lr, crossed.back(), down, true);
+         }
+
+         for (size_t j = 0; j != crossed.size(); ++j)
+         {
+            size_t nd = traps_[crossed[j]].node;
+            size_t y = new_node(Y_NODE, si, traps_[split[j].first].node, traps_[split[j].second].node);
+
+            if (j + 1 == crossed.size() && has_right)
+            {
+               y = new_node(X_NODE, r, y, traps_[right].node);
+            }
+
+            if (j == 0 && has_left)
+            {
+               y = new_node(X_NODE, l, traps_[left].node, y);
+            }
+
+            // parents refer to the node of the old trapezoid, it is replaced in place
+            nodes_[nd] = nodes_[y];
+            nodes_.pop_back();
+
+            if (nodes_[nd].kind == LEAF)
+            {
+               traps_[nodes_[nd].index].node = nd;
+            }
+         }
+      }
+
+   public:
+      // contour has to be simple, the order of the edges is shuffled with seed
+      explicit trapezoidal_map_2t(contour_2t<Scalar> const & contour, uint64_t seed = 0)
+         : contour_(contour)
+      {
+         if (contour.size() < 3)
+         {
+            return;
+         }
+
+         bool ccw = counterclockwise(contour);
+
+         for (size_t i = 0; i != contour.size(); ++i)
+         {
+            point const & a = contour[i], & b = contour[(i + 1) % contour.size()];
+
+            if (a == b)
+            {
+               continue;
+            }
+
+            segment s = {std::min(a, b), std::max(a, b), (a < b) == ccw};
+            segs_.push_back(s);
+         }
+
+         points_.assign(contour.begin(), contour.end());
+         std::sort(points_.begin(), points_.end());
+         points_.erase(std::unique(points_.begin(), points_.end()), points_.end());
+
+         std::mt19937_64 random(seed);
+         std::shuffle(segs_.begin(), segs_.end(), random);
+
+         new_trapezoid(none, none, none, none);
+
+         for (size_t i = 0; i != segs_.size(); ++i)
+         {
+            insert(i);
+         }
+
+         crossed_.clear();
+         split_.clear();
+      }
+
+      bool contains(point const & q) const
+      {
+         if (segs_.empty())
+         {
+            return cg::contains(contour_, q);
+         }
+
+         size_t nd = 0;
+
+         while (nodes_[nd].kind != LEAF)
+         {
+            node const & n = nodes_[nd];
+
+            if (n.kind == X_NODE)
+            {
+               point const & p = points_[n.index];
+
+               if (q == p)
+               {
+                  return true;
+               }
+
+               nd = (q < p) ? n.left : n.right;
+            }
+            else
+            {
+               segment const & t = segs_[n.index];
+               orientation_t o = orientation(t.l, t.r, q);
+
+               if (o == CG_COLLINEAR)
+               {
+                  return true;
+               }
+
+               nd = (o == CG_LEFT) ? n.left : n.right;
+            }
+         }
+
+         size_t bottom = traps_[nodes_[nd].index].bottom;
+         return bottom != none && segs_[bottom].inside_above;
+      }
+
+      // contains for each point of [p, q) written to out
+      template <class InputIter, class OutIter>
+      OutIter contains(InputIter p, InputIter q, OutIter out) const
+      {
+         for (; p != q; ++p)
+         {
+            *out++ = contains(*p);
+         }
+
+         return out;
+      }
+
+      // the batch contains on several threads, out is random access
+      template <class RandIter, class OutIter>
+      OutIter parallel_contains(RandIter p, RandIter q, OutIter out, size_t threads = std::thread::hardware_concurrency()) const
+      {
+         if (threads < 2 || size_t(q - p) < detail::PARALLEL_HULL_CUTOFF)
+         {
+            return contains(p, q, out);
+         }
+
+         std::vector<std::future<void> > parts;
+
+         for (auto const & r : detail::split(p, q, threads))
+         {
+            OutIter o = out + (r.first - p);
+
+            parts.push_back(std::async(std::launch::async, [this, r, o] ()
+            {
+               contains(r.first, r.second, o);
+            }));
+         }
+
+         for (auto & part : parts)
+         {
+            part.get();
+         }
+
+         return out + (q - p);
+      }
+
+   private:
+      contour_2t<Scalar> contour_;
+      std::vector<point> points_;
+      std::vector<segment> segs_;
+      // the trapezoids split by insert stay here unused
+      std::vector<trapezoid> traps_;
+      std::vector<node> nodes_;
+
+      // buffers of insert
+      std::vector<size_t> crossed_;
+      std::vector<std::pair<size_t, size_t> > split_;
+   };
+}
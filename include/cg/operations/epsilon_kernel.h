@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+#include <cg/common/constants.h>
+#include <cg/primitives/point.h>
+#include <cg/primitives/vector.h>
+#include <cg/convex_hull/andrew.h>
+#include <cg/operations/rotating_calipers.h>
+
+namespace cg
+{
+   template <class Scalar>
+   class epsilon_kernel_2t;
+
+   typedef epsilon_kernel_2t<double> epsilon_kernel_2;
+
+   // online coreset for the diameter and the directional extents of a stream of points.
+   //
+   // keeps the extreme point of the stream in each of k evenly spaced directions, k is
+   // the smallest even number not below pi / sqrt(2 eps), so memory is O(1 / sqrt(eps))
+   // and add_point is O(1 / sqrt(eps)).
+   //
+   // error bounds, D is the diameter of the stream, theta = pi / k:
+   //  - extents in the k directions are exact: k is even, so the opposite of a kept
+   //    direction is kept as well and gives the minimum;
+   //  - the diameter of the kernel is at least D cos(theta) >= (1 - eps) D: the direction
+   //    of a farthest pair is within theta of a kept one, in which the kernel spans the
+   //    same extent as the stream;
+   //  - the extent in any other direction is underestimated by at most 2 D sin(theta),
+   //    which is below 2 sqrt(2 eps) D: build the kernel with eps^2 / 8 to get extents
+   //    within eps D
+   template <class Scalar>
+   class epsilon_kernel_2t
+   {
+      typedef point_2t<Scalar> point;
+
+   public:
+      explicit epsilon_kernel_2t(double eps)
+         : count_(0)
+      {
+         size_t k = std::max(4., std::ceil(pi / std::sqrt(2 * eps)));
+         k += k % 2;
+
+         for (size_t i = 0; i != k; ++i)
+         {
+            double a = 2 * pi * i / k;
+            dirs_.push_back(vector_2t<double>(std::cos(a), std::sin(a)));
+         }
+
+         extreme_.resize(k);
+         value_.resize(k);
+      }
+
+      void add_point(point const & p)
+      {
+         vector_2t<double> v(p.x, p.y);
+
+         for (size_t i = 0; i != dirs_.size(); ++i)
+         {
+            double d = dirs_[i] * v;
+
+            if (count_ == 0 || d > value_[i])
+            {
+               value_[i] = d;
+               extreme_[i] = p;
+            }
+         }
+
+         ++count_;
+      }
+
+      template <class InputIter>
+      void add_points(InputIter p, InputIter q)
+      {
+         for (; p != q; ++p)
+         {
+            add_point(*p);
+         }
+      }
+
+      // after merge the kernel is a kernel of the points of both streams, other has to be
+      // built with the same eps
+      void merge(epsilon_kernel_2t const & other)
+      {
+         if (other.count_ != 0)
+         {
+            size_t count = count_ + other.count_;
+            add_points(other.extreme_.begin(), other.extreme_.end());
+            count_ = count;
+         }
+      }
+
+      void clear()
+      {
+         count_ = 0;
+      }
+
+      bool empty() const
+      {
+         return count_ == 0;
+      }
+
+      // number of points of the stream
+      size_t count() const
+      {
+         return count_;
+      }
+
+      size_t directions() const
+      {
+         return dirs_.size();
+      }
+
+      // hull of the kernel in andrew_hull order, rotating_calipers and diameter can be run
+      // on it instead of the stream
+      std::vector<point> hull() const
+      {
+         std::vector<point> res;
+
+         if (count_ != 0)
+         {
+            res = extreme_;
+            res.erase(andrew_hull(res.begin(), res.end()), res.end());
+         }
+
+         return res;
+      }
+
+      // approximate diameter, at least (1 - eps) of the one of the stream
+      double diameter() const
+      {
+         std::vector<point> h = hull();
+
+         if (h.empty())
+         {
+            return 0;
+         }
+
+         std::pair<size_t, size_t> d = hull_diameter(h.begin(), h.end());
+         vector_2t<Scalar> v = h[d.second] - h[d.first];
+         return std::sqrt(double(v * v));
+      }
+
+      // max - min of u * p over the kernel, u is a unit vector
+      double extent(vector_2t<double> const & u) const
+      {
+         if (count_ == 0)
+         {
+            return 0;
+         }
+
+         double lo = u * vector_2t<double>(extreme_[0].x, extreme_[0].y), hi = lo;
+
+         for (point const & p : extreme_)
+         {
+            double d = u * vector_2t<double>(p.x, p.y);
+            lo = std::min(lo, d);
+            hi = std::max(hi, d);
+         }
+
+         return hi - lo;
+      }
+
+   private:
+      std::vector<vector_2t<double> > dirs_;
+      std::vector<point> extreme_;
+      std::vector<double> value_;
+      size_t count_;
+   };
+}
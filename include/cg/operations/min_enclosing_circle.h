@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <random>
+
+#include <boost/numeric/interval.hpp>
+#include <boost/optional.hpp>
+#include <gmpxx.h>
+
+#include <cg/primitives/point.h>
+#include <cg/primitives/triangle.h>
+#include <cg/primitives/circle.h>
+#include <cg/operations/orientation.h>
+#include <cg/operations/contains/circumcircle_point.h>
+
+namespace cg
+{
+   // (p - a) * (p - b) > 0: p is outside of the circle with the diameter ab
+
+   struct outside_diametral_circle_d
+   {
+      boost::optional<bool> operator() (point_2 const & a, point_2 const & b, point_2 const & p) const
+      {
+         double m1 = (p.x - a.x) * (p.x - b.x);
+         double m2 = (p.y - a.y) * (p.y - b.y);
+         double res = m1 + m2;
+         double eps = (fabs(m1) + fabs(m2)) * 8 * std::numeric_limits<double>::epsilon();
+
+         if (res > eps)
+         {
+            return true;
+         }
+
+         if (res < -eps)
+         {
+            return false;
+         }
+
+         return boost::none;
+      }
+   };
+
+   struct outside_diametral_circle_i
+   {
+      boost::optional<bool> operator() (point_2 const & a, point_2 const & b, point_2 const & p) const
+      {
+         typedef boost::numeric::interval_lib::unprotect<boost::numeric::interval<double> >::type interval;
+         boost::numeric::interval<double>::traits_type::rounding _;
+
+         interval res = (interval(p.x) - a.x) * (interval(p.x) - b.x) + (interval(p.y) - a.y) * (interval(p.y) - b.y);
+
+         if (res.lower() > 0)
+         {
+            return true;
+         }
+
+         if (res.upper() <= 0)
+         {
+            return false;
+         }
+
+         return boost::none;
+      }
+   };
+
+   struct outside_diametral_circle_r
+   {
+      boost::optional<bool> operator() (point_2 const & a, point_2 const & b, point_2 const & p) const
+      {
+         mpq_class res = (mpq_class(p.x) - a.x) * (mpq_class(p.x) - b.x) + (mpq_class(p.y) - a.y) * (mpq_class(p.y) - b.y);
+         return res > 0;
+      }
+   };
+
+   inline bool outside_diametral_circle(point_2 const & a, point_2 const & b, point_2 const & p)
+   {
+      if (boost::optional<bool> v = outside_diametral_circle_d()(a, b, p))
+      {
+         return *v;
+      }
+
+      if (boost::optional<bool> v = outside_diametral_circle_i()(a, b, p))
+      {
+         return *v;
+      }
+
+      return *outside_diametral_circle_r()(a, b, p);
+   }
+
+   namespace detail
+   {
+      // the points on the boundary of the current circle, a triple is counterclockwise
+      template <class RandIter>
+      struct circle_support
+      {
+         RandIter pts[3];
+         size_t size;
+
+         bool outside(point_2 const & p) const
+         {
+            switch (size)
+            {
+            case 1:  return p != *pts[0];
+            case 2:  return outside_diametral_circle(*pts[0], *pts[1], p);
+            // strictly inside of the circle of the clockwise triple means strictly outside
+            default: return circumcircle_contains(triangle_2(*pts[0], *pts[2], *pts[1]), p);
+            }
+         }
+
+         circle_2 circle() const
+         {
+            point_2 const & a = *pts[0];
+            point_2 center = a;
+
+            if (size == 2)
+            {
+               point_2 const & b = *pts[1];
+               center = point_2((a.x + b.x) / 2, (a.y + b.y) / 2);
+            }
+            else if (size == 3)
+            {
+               vector_2 b = *pts[1] - a, c = *pts[2] - a;
+               double d = 2 * (b ^ c);
+               double bb = b * b, cc = c * c;
+               center = point_2(a.x + (c.y * bb - b.y * cc) / d, a.y + (b.x * cc - c.x * bb) / d);
+            }
+
+            // the rounded center is covered from the farthest support point
+            double r = 0;
+
+            for (size_t i = 0; i != size; ++i)
+            {
+               vector_2 v = *pts[i] - center;
+               r = std::max(r, std::sqrt(v * v));
+            }
+
+            return circle_2(center, r);
+         }
+      };
+
+      // move-to-front welzl on a shuffled range, every circle test is exact
+      template <class RandIter>
+      circle_2 min_enclosing_circle(RandIter p, RandIter q)
+      {
+         if (p == q)
+         {
+            return circle_2();
+         }
+
+         circle_support<RandIter> c = {{p}, 1};
+
+         for (RandIter i = p + 1; i != q; ++i)
+         {
+            if (!c.outside(*i))
+            {
+               continue;
+            }
+
+            c.pts[0] = i;
+            c.size = 1;
+
+            // i is on the boundary of the circle of [p, i]
+            for (RandIter j = p; j != i; ++j)
+            {
+               if (!c.outside(*j))
+               {
+                  continue;
+               }
+
+               c.pts[1] = j;
+               c.size = 2;
+
+               // i and j are on the boundary of the circle of [p, j] and i
+               for (RandIter k = p; k != j; ++k)
+               {
+                  if (!c.outside(*k))
+                  {
+                     continue;
+                  }
+
+                  orientation_t o = orientation(*i, *j, *k);
+                  assert(o != CG_COLLINEAR);
+
+                  c.pts[0] = i;
+                  c.pts[1] = (o == CG_LEFT) ? j : k;
+                  c.pts[2] = (o == CG_LEFT) ? k : j;
+                  c.size = 3;
+               }
+            }
+         }
+
+         return c.circle();
+      }
+   }
+
+   // smallest circle enclosing [p, q) in expected O(n), the range is shuffled. the
+   // boundary points are chosen with exact predicates, the center and the radius are
+   // rounded so that the circle covers them. an empty range gives a zero circle
+   template <class RandIter>
+   circle_2 min_enclosing_circle(RandIter p, RandIter q, uint64_t seed = 0)
+   {
+      std::mt19937_64 random(seed);
+      std::shuffle(p, q, random);
+      return detail::min_enclosing_circle(p, q);
+   }
+
+   // min_enclosing_circle of every group of points, group k is [points + offsets[k],
+   // points + offsets[k + 1]) for the offsets [first, last). groups are shuffled in place
+   // and nothing is allocated, one circle per group is written to out
+   template <class RandIter, class OffsetIter, class OutIter>
+   OutIter min_enclosing_circles(RandIter points, OffsetIter first, OffsetIter last, OutIter out, uint64_t seed = 0)
+   {
+      std::mt19937_64 random(seed);
+
+      if (first == last)
+      {
+         return out;
+      }
+
+      for (OffsetIter next = std::next(first); next != last; first = next++)
+      {
+         RandIter p = points + *first, q = points + *next;
+         std::shuffle(p, q, random);
+         *out++ = detail::min_enclosing_circle(p, q);
+      }
+
+      return out;
+   }
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/optional.hpp>
+
+#include <cg/common/constants.h>
+#include <cg/primitives/point.h>
+#include <cg/primitives/vector.h>
+
+namespace cg
+{
+   template <class Scalar>
+   class online_simplifier_2t;
+
+   typedef online_simplifier_2t<double> online_simplifier_2;
+
+   // simplification of a polyline that arrives point by point (opening window with the
+   // cone intersection of sleeve algorithms): O(1) time per point and one buffered point.
+   //
+   // as in simplify, every dropped vertex is within eps (up to rounding) of the segment
+   // between the kept vertices around it and the first and the last vertices are kept.
+   // a candidate end of the segment from the last kept vertex a is accepted if it is in
+   // the intersection of the cones of directions from a passing within eps of the
+   // dropped vertices and is at least as far from a as they are. more vertices than
+   // with simplify are usually kept, but nothing waits for the end of the polyline
+   template <class Scalar>
+   class online_simplifier_2t
+   {
+      typedef point_2t<Scalar> point;
+
+   public:
+      explicit online_simplifier_2t(double eps)
+         : eps_(eps)
+      {
+         clear();
+      }
+
+      // the vertex kept by this point if any, it is always the previous point or the
+      // first one
+      boost::optional<point> add_point(point const & p)
+      {
+         if (!anchor_)
+         {
+            anchor_ = p;
+            return p;
+         }
+
+         if (!pending_)
+         {
+            pending_ = p;
+            return boost::none;
+         }
+
+         cone c = cone_;
+
+         if (eps_ < 0 || !constrain(c, *pending_) || !accepts(c, p))
+         {
+            // the pending point is kept and starts the next segment
+            anchor_ = pending_;
+            pending_ = p;
+            cone_ = cone();
+            return anchor_;
+         }
+
+         cone_ = c;
+         pending_ = p;
+         return boost::none;
+      }
+
+      // the last vertex of the polyline if it is not kept yet, the simplifier is ready
+      // for the next polyline after it
+      boost::optional<point> finish()
+      {
+         boost::optional<point> res = pending_;
+         clear();
+         return res;
+      }
+
+      void clear()
+      {
+         anchor_ = boost::none;
+         pending_ = boost::none;
+         cone_ = cone();
+      }
+
+   private:
+      // directions from the anchor as angles relative to ref, [lo, hi] is within
+      // [-pi / 2, pi / 2]
+      struct cone
+      {
+         bool bounded;
+         double ref, lo, hi, reach;
+
+         cone()
+            : bounded(false)
+            , ref(0)
+            , lo(0)
+            , hi(0)
+            , reach(0)
+         {}
+      };
+
+      double angle(cone const & c, vector_2t<double> const & v) const
+      {
+         double a = std::atan2(v.y, v.x) - c.ref;
+
+         if (a > pi)
+         {
+            a -= 2 * pi;
+         }
+         else if (a < -pi)
+         {
+            a += 2 * pi;
+         }
+
+         return a;
+      }
+
+      vector_2t<double> from_anchor(point const & p) const
+      {
+         return vector_2t<double>(double(p.x) - anchor_->x, double(p.y) - anchor_->y);
+      }
+
+      // adds the cone of q to c, false if it becomes empty
+      bool constrain(cone & c, point const & q) const
+      {
+         vector_2t<double> v = from_anchor(q);
+         double d = std::sqrt(v * v);
+
+         // q is within eps of any segment from the anchor
+         if (d <= eps_)
+         {
+            return true;
+         }
+
+         if (!c.bounded)
+         {
+            c.bounded = true;
+            c.ref = std::atan2(v.y, v.x);
+            c.lo = -pi / 2;
+            c.hi = pi / 2;
+         }
+
+         double a = angle(c, v), half = std::asin(eps_ / d);
+
+         c.lo = std::max(c.lo, a - half);
+         c.hi = std::min(c.hi, a + half);
+         c.reach = std::max(c.reach, d);
+
+         return c.lo <= c.hi;
+      }
+
+      bool accepts(cone const & c, point const & p) const
+      {
+         if (!c.bounded)
+         {
+            return true;
+         }
+
+         vector_2t<double> v = from_anchor(p);
+
+         if (v * v < c.reach * c.reach)
+         {
+            return false;
+         }
+
+         double a = angle(c, v);
+         return c.lo <= a && a <= c.hi;
+      }
+
+      double eps_;
+      boost::optional<point> anchor_, pending_;
+      cone cone_;
+   };
+}
@@ -202,7 +202,7 @@ namespace cg
          return *v;
       }
 
-      return *orientation_r<Scalar>()(a, b, c);
+      return *orientation_r<Scalar>()(a, b, c, d);
    }
    template <class Scalar>
    inline bool counterclockwise(contour_2t<Scalar> const & c)
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "cg/primitives/point_3.h"
+#include "cg/primitives/point.h"
+#include "cg/operations/orientation.h"
+#include <boost/numeric/interval.hpp>
+#include <gmpxx.h>
+
+#include <boost/optional.hpp>
+
+namespace cg
+{
+   // sign of det(b - a, c - a, d - a): CG_LEFT if d is on the side of the plane abc
+   // from which a, b, c are seen counterclockwise, CG_COLLINEAR if the points are coplanar
+
+   template <class Scalar>
+   struct orientation_3_d
+   {
+      boost::optional<orientation_t> operator() (point_3t<Scalar> const & a, point_3t<Scalar> const & b, point_3t<Scalar> const & c, point_3t<Scalar> const & d) const
+      {
+         Scalar ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+         Scalar vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+         Scalar wx = d.x - a.x, wy = d.y - a.y, wz = d.z - a.z;
+
+         Scalar m1 = vy * wz, m2 = vz * wy;
+         Scalar m3 = vx * wz, m4 = vz * wx;
+         Scalar m5 = vx * wy, m6 = vy * wx;
+
+         Scalar res = ux * (m1 - m2) - uy * (m3 - m4) + uz * (m5 - m6);
+         Scalar eps = (fabs(ux) * (fabs(m1) + fabs(m2))
+                       + fabs(uy) * (fabs(m3) + fabs(m4))
+                       + fabs(uz) * (fabs(m5) + fabs(m6))) * 16 * std::numeric_limits<Scalar>::epsilon();
+
+         if (res > eps)
+         {
+            return CG_LEFT;
+         }
+
+         if (res < -eps)
+         {
+            return CG_RIGHT;
+         }
+
+         return boost::none;
+      }
+   };
+
+   template <class Scalar>
+   struct orientation_3_i
+   {
+      boost::optional<orientation_t> operator() (point_3t<Scalar> const & a, point_3t<Scalar> const & b, point_3t<Scalar> const & c, point_3t<Scalar> const & d) const
+      {
+         typedef typename boost::numeric::interval_lib::unprotect<typename boost::numeric::interval<Scalar> >::type interval;
+
+         typename boost::numeric::interval<Scalar>::traits_type::rounding _;
+         interval ux = interval(b.x) - a.x, uy = interval(b.y) - a.y, uz = interval(b.z) - a.z;
+         interval vx = interval(c.x) - a.x, vy = interval(c.y) - a.y, vz = interval(c.z) - a.z;
+         interval wx = interval(d.x) - a.x, wy = interval(d.y) - a.y, wz = interval(d.z) - a.z;
+
+         interval res =   ux * (vy * wz - vz * wy)
+                        - uy * (vx * wz - vz * wx)
+                        + uz * (vx * wy - vy * wx);
+
+         if (res.lower() > 0)
+         {
+            return CG_LEFT;
+         }
+
+         if (res.upper() < 0)
+         {
+            return CG_RIGHT;
+         }
+
+         if (res.upper() == res.lower())
+         {
+            return CG_COLLINEAR;
+         }
+
+         return boost::none;
+      }
+   };
+
+   template <class Scalar>
+   struct orientation_3_r
+   {
+      boost::optional<orientation_t> operator() (point_3t<Scalar> const & a, point_3t<Scalar> const & b, point_3t<Scalar> const & c, point_3t<Scalar> const & d) const
+      {
+         mpq_class ux = mpq_class(b.x) - a.x, uy = mpq_class(b.y) - a.y, uz = mpq_class(b.z) - a.z;
+         mpq_class vx = mpq_class(c.x) - a.x, vy = mpq_class(c.y) - a.y, vz = mpq_class(c.z) - a.z;
+         mpq_class wx = mpq_class(d.x) - a.x, wy = mpq_class(d.y) - a.y, wz = mpq_class(d.z) - a.z;
+
+         mpq_class res =   ux * (vy * wz - vz * wy)
+                         - uy * (vx * wz - vz * wx)
+                         + uz * (vx * wy - vy * wx);
+
+         int cres = cmp(res, 0);
+
+         if (cres > 0)
+         {
+            return CG_LEFT;
+         }
+
+         if (cres < 0)
+         {
+            return CG_RIGHT;
+         }
+
+         return CG_COLLINEAR;
+      }
+   };
+
+   template <class Scalar>
+   inline orientation_t orientation(point_3t<Scalar> const & a, point_3t<Scalar> const & b, point_3t<Scalar> const & c, point_3t<Scalar> const & d)
+   {
+      if (boost::optional<orientation_t> v = orientation_3_d<Scalar>()(a, b, c, d))
+      {
+         return *v;
+      }
+
+      if (boost::optional<orientation_t> v = orientation_3_i<Scalar>()(a, b, c, d))
+      {
+         return *v;
+      }
+
+      return *orientation_3_r<Scalar>()(a, b, c, d);
+   }
+
+   // exact, the projections on the coordinate planes are all collinear
+   template <class Scalar>
+   inline bool collinear(point_3t<Scalar> const & a, point_3t<Scalar> const & b, point_3t<Scalar> const & c)
+   {
+      typedef point_2t<Scalar> point;
+
+      return orientation(point(a.x, a.y), point(b.x, b.y), point(c.x, c.y)) == CG_COLLINEAR
+          && orientation(point(a.y, a.z), point(b.y, b.z), point(c.y, c.z)) == CG_COLLINEAR
+          && orientation(point(a.x, a.z), point(b.x, b.z), point(c.x, c.z)) == CG_COLLINEAR;
+   }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cg/operations/simplify.h>
+
+namespace cg
+{
+   namespace detail
+   {
+      // polylines per task of a thread
+      const size_t SIMPLIFY_BLOCK = 64;
+   }
+
+   // simplify of many polylines in csr layout: polyline k is [points + offsets[k],
+   // points + offsets[k + 1]) for the offsets [first, last).
+   //
+   // the indices (relative to points) of the vertices kept in polyline k are written to
+   // kept[offsets[k]], kept[offsets[k] + 1], ... and their number to counts[k], so kept
+   // needs as many entries as there are points and nothing is allocated per polyline.
+   // blocks of polylines are taken by the threads on demand. returns the number of kept
+   // vertices
+   template <class RandIter, class OffsetIter, class IndexIter, class CountIter>
+   size_t simplify_polylines(RandIter points, OffsetIter first, OffsetIter last, double eps,
+                             IndexIter kept, CountIter counts, size_t threads = std::thread::hardware_concurrency())
+   {
+      if (first == last)
+      {
+         return 0;
+      }
+
+      size_t polylines = std::distance(first, last) - 1;
+      double threshold = detail::squared_threshold(eps);
+      std::atomic<size_t> next(0);
+
+      auto work = [&] ()
+      {
+         std::vector<std::pair<size_t, size_t> > stack;
+         size_t res = 0;
+
+         for (size_t block; (block = next.fetch_add(detail::SIMPLIFY_BLOCK)) < polylines; )
+         {
+            for (size_t k = block; k != std::min(block + detail::SIMPLIFY_BLOCK, polylines); ++k)
+            {
+               size_t from = first[k], to = first[k + 1];
+               RandIter p = points + from;
+               IndexIter out = kept + from;
+
+               detail::douglas_peucker(to - from, threshold,
+                                       [p] (size_t a, size_t b) { return detail::farthest_from_segment(p, a, b); },
+                                       [from, &out] (size_t i) { *out++ = from + i; },
+                                       stack);
+
+               counts[k] = out - (kept + from);
+               res += counts[k];
+            }
+         }
+
+         return res;
+      };
+
+      threads = std::max<size_t>(1, std::min(threads, (polylines + detail::SIMPLIFY_BLOCK - 1) / detail::SIMPLIFY_BLOCK));
+
+      std::vector<std::future<size_t> > parts;
+
+      for (size_t t = 1; t < threads; ++t)
+      {
+         parts.push_back(std::async(std::launch::async, work));
+      }
+
+      size_t res = work();
+
+      for (auto & part : parts)
+      {
+         res += part.get();
+      }
+
+      return res;
+   }
+}
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+#include <cg/primitives/point.h>
+#include <cg/primitives/vector.h>
+#include <cg/operations/orientation.h>
+#include <cg/operations/compare_dist.h>
+
+// rotating calipers over a precomputed hull: [p, q) are the vertices of a strictly convex
+// polygon in counterclockwise order, as returned by andrew_hull. results are indices
+// relative to p, nothing is allocated.
+//
+// the antipodal sweep is driven by the exact orientation predicate and the diameter is
+// chosen with the exact compare_dist, widths, areas and perimeters are computed in double
+
+namespace cg
+{
+   // rectangle with a side on the line of the edge (edge, edge + 1), right, top and left
+   // are the vertices on the other sides in counterclockwise order
+   struct enclosing_rectangle
+   {
+      size_t edge, right, top, left;
+      double area, perimeter;
+   };
+
+   struct calipers_result
+   {
+      std::pair<size_t, size_t> diameter;
+
+      // distance from the edge (width_edge, width_edge + 1) to the vertex width_vertex
+      size_t width_edge, width_vertex;
+      double width;
+
+      enclosing_rectangle min_area, min_perimeter;
+   };
+
+   namespace detail
+   {
+      struct ignore_output
+      {
+         ignore_output & operator * ()  { return *this; }
+         ignore_output & operator ++ () { return *this; }
+         ignore_output & operator ++ (int) { return *this; }
+
+         template <class T>
+         ignore_output & operator = (T const &) { return *this; }
+      };
+
+      template <class Point>
+      double dot(Point const & a, Point const & b, Point const & c, Point const & d)
+      {
+         return (b - a) * (d - c);
+      }
+
+      template <class RandIter, class OutIter>
+      calipers_result rotating_calipers(RandIter p, RandIter q, OutIter & out)
+      {
+         typedef typename std::iterator_traits<RandIter>::value_type point;
+
+         size_t n = q - p;
+
+         calipers_result res;
+         res.diameter = std::make_pair(0, 0);
+         res.width_edge = res.width_vertex = 0;
+         res.width = 0;
+
+         enclosing_rectangle empty = {0, 0, 0, 0, 0, 0};
+         res.min_area = res.min_perimeter = empty;
+
+         if (n < 3)
+         {
+            if (n == 2)
+            {
+               res.diameter = std::make_pair(0, 1);
+               *out++ = res.diameter;
+
+               double len = std::sqrt(dot(p[0], p[1], p[0], p[1]));
+               enclosing_rectangle segment = {0, 1, 0, 0, 0, 2 * len};
+               res.min_area = res.min_perimeter = segment;
+            }
+
+            return res;
+         }
+
+         auto next = [n] (size_t i) { return (i + 1 == n) ? 0 : i + 1; };
+
+         // vertex farthest from the last edge
+         size_t top = 0;
+
+         while (orientation(p[n - 1], p[0], p[top], p[next(top)]) == CG_LEFT)
+         {
+            top = next(top);
+         }
+
+         size_t right = 0, left = top;
+
+         for (size_t i = 0; i != n; ++i)
+         {
+            size_t i1 = next(i);
+            point const & a = p[i];
+            point const & b = p[i1];
+
+            // vertices between the tops of the previous edge and of this one are antipodal
+            // to i, every pair is met from both of its ends
+            auto emit = [&] (size_t j)
+            {
+               if (i >= j)
+               {
+                  return;
+               }
+
+               *out++ = std::make_pair(i, j);
+
+               if (compare_dist(p[res.diameter.first], p[res.diameter.second], p[i], p[j]))
+               {
+                  res.diameter = std::make_pair(i, j);
+               }
+            };
+
+            emit(top);
+
+            orientation_t turn;
+
+            while ((turn = orientation(a, b, p[top], p[next(top)])) == CG_LEFT)
+            {
+               top = next(top);
+               emit(top);
+            }
+
+            // the edges are parallel, both of their ends are antipodal to i
+            if (turn == CG_COLLINEAR)
+            {
+               emit(next(top));
+            }
+
+            while (dot(a, b, p[right], p[next(right)]) > 0)
+            {
+               right = next(right);
+            }
+
+            if (i == 0)
+            {
+               left = top;
+            }
+
+            while (dot(a, b, p[left], p[next(left)]) < 0)
+            {
+               left = next(left);
+            }
+
+            double len = std::sqrt(dot(a, b, a, b));
+            double height = ((b - a) ^ (p[top] - a)) / len;
+            double length = dot(a, b, p[left], p[right]) / len;
+
+            enclosing_rectangle r = {i, right, top, left, height * length, 2 * (height + length)};
+
+            if (i == 0 || height < res.width)
+            {
+               res.width_edge = i;
+               res.width_vertex = top;
+               res.width = height;
+            }
+
+            if (i == 0 || r.area < res.min_area.area)
+            {
+               res.min_area = r;
+            }
+
+            if (i == 0 || r.perimeter < res.min_perimeter.perimeter)
+            {
+               res.min_perimeter = r;
+            }
+         }
+
+         return res;
+      }
+   }
+
+   // diameter, width and the minimal area and perimeter enclosing rectangles in one
+   // sweep, the antipodal pairs (i, j), i < j, are written to out as they are found
+   template <class RandIter, class OutIter>
+   calipers_result rotating_calipers(RandIter p, RandIter q, OutIter out)
+   {
+      return detail::rotating_calipers(p, q, out);
+   }
+
+   template <class RandIter>
+   calipers_result rotating_calipers(RandIter p, RandIter q)
+   {
+      detail::ignore_output out;
+      return detail::rotating_calipers(p, q, out);
+   }
+
+   // antipodal pairs (i, j), i < j, of the convex polygon [p, q)
+   template <class RandIter, class OutIter>
+   OutIter antipodal_pairs(RandIter p, RandIter q, OutIter out)
+   {
+      detail::rotating_calipers(p, q, out);
+      return out;
+   }
+
+   // indices of the farthest pair of vertices of the convex polygon [p, q)
+   template <class RandIter>
+   std::pair<size_t, size_t> hull_diameter(RandIter p, RandIter q)
+   {
+      return rotating_calipers(p, q).diameter;
+   }
+
+   // corners of the rectangle r enclosing the convex polygon [p, q), counterclockwise
+   // starting from the one on the line of r.edge next to r.left
+   template <class RandIter>
+   std::array<point_2t<double>, 4> rectangle_corners(RandIter p, RandIter q, enclosing_rectangle const & r)
+   {
+      size_t n = q - p;
+      point_2t<double> a = p[r.edge], b = p[(r.edge + 1) % n];
+
+      vector_2t<double> u = b - a;
+      u *= 1 / std::sqrt(u * u);
+      vector_2t<double> v(-u.y, u.x);
+
+      double h = (p[r.top] - a) * v;
+      point_2t<double> from = a, to = a;
+      from += ((p[r.left] - a) * u) * u;
+      to += ((p[r.right] - a) * u) * u;
+
+      std::array<point_2t<double>, 4> res = {{from, to, to, from}};
+      res[2] += h * v;
+      res[3] += h * v;
+      return res;
+   }
+}
@@ -1,61 +1,402 @@
 #pragma once
 
-#include "cg/primitives/segment.h"
-#include "cg/operations/distance.h"
-
-#include <boost/utility.hpp>
+#include "cg/primitives/point.h"
+#include "cg/primitives/vector.h"
+#include "cg/operations/orientation.h"
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
 
 namespace cg
 {
+   // pass as the last argument of simplify to find the farthest vertices with path hulls
+   struct path_hull_t {};
+   const path_hull_t path_hull = path_hull_t();
+
    namespace detail
    {
-      template <class BidIter, class OutIter>
-      OutIter simplify_impl(BidIter p, BidIter q, OutIter out, double eps)
+      // squared distance from p to the segment ab
+      template <class Point>
+      double squared_distance_to_segment(Point const & a, Point const & b, Point const & p)
       {
-         --q;
+         auto v = b - a, w = p - a;
+         double t = v * w;
 
-         if (p == q)
+         if (t <= 0)
          {
-            return out;
+            return w * w;
          }
 
-         typedef typename std::iterator_traits<BidIter>::value_type point;
-         typedef typename point::scalar_type Scalar;
+         double vv = v * v;
 
-         segment_2t<Scalar> s(*p, *q);
-         BidIter it_max = std::max_element(boost::next(p), q, [p, q, &s](const point a, point b)
+         if (t >= vv)
          {
-            return distance(s, a) < distance(s, b);
-         });
+            auto u = p - b;
+            return u * u;
+         }
 
-         auto max = distance(s, *it_max);
+         double c = v ^ w;
+         return c * c / vv;
+      }
 
-         if (max > eps)
+      // a distance is above eps iff its square is above this
+      inline double squared_threshold(double eps)
+      {
+         return (eps < 0) ? -1 : eps * eps;
+      }
+
+      // douglas-peucker on the vertices 0 .. n - 1 with an explicit stack, reused between
+      // the calls. farthest(a, b) is the vertex of (a, b) splitting a, b with the square
+      // of its distance (b if there is none), kept(i) is called for the kept vertices in
+      // order. the first and the last vertices are always kept
+      template <class Farthest, class Kept>
+      void douglas_peucker(size_t n, double threshold, Farthest farthest, Kept kept,
+                           std::vector<std::pair<size_t, size_t> > & stack)
+      {
+         if (n == 0)
          {
-            out = simplify_impl(p, boost::next(it_max), out, eps);
-            return simplify_impl(it_max, ++q, out, eps);
+            return;
          }
-         else
+
+         kept(0);
+         stack.assign(1, std::make_pair(0, n - 1));
+
+         while (!stack.empty())
          {
-            *out++ = *q;
-            return out;
+            size_t a = stack.back().first, b = stack.back().second;
+            stack.pop_back();
+
+            if (a == b)
+            {
+               continue;
+            }
+
+            std::pair<double, size_t> far = (b - a > 1) ? farthest(a, b) : std::make_pair(-1., b);
+
+            if (far.second != b && far.first > threshold)
+            {
+               stack.push_back(std::make_pair(far.second, b));
+               stack.push_back(std::make_pair(a, far.second));
+            }
+            else
+            {
+               kept(b);
+            }
          }
       }
-   }
 
-   template <class BidIter, class OutIter>
-   OutIter simplify(BidIter p, BidIter q, OutIter out, double eps)
-   {
-      if (p == q)
+      // the first vertex of (a, b) farthest from the segment p[a], p[b] and the square of
+      // its distance
+      template <class RandIter>
+      std::pair<double, size_t> farthest_from_segment(RandIter p, size_t a, size_t b)
+      {
+         std::pair<double, size_t> res(-1, b);
+
+         for (size_t i = a + 1; i < b; ++i)
+         {
+            double d = squared_distance_to_segment(p[a], p[b], p[i]);
+
+            if (d > res.first)
+            {
+               res = std::make_pair(d, i);
+            }
+         }
+
+         return res;
+      }
+
+      template <class RandIter, class OutIter>
+      OutIter simplify(RandIter p, RandIter q, OutIter out, double eps, std::random_access_iterator_tag)
       {
+         std::vector<std::pair<size_t, size_t> > stack;
+
+         douglas_peucker(q - p, squared_threshold(eps),
+                         [p] (size_t a, size_t b) { return farthest_from_segment(p, a, b); },
+                         [p, &out] (size_t i) { *out++ = p[i]; },
+                         stack);
+
          return out;
       }
 
-      *out++ = *p;
-      return detail::simplify_impl(p, q, out, eps);
+      template <class BidIter, class OutIter>
+      OutIter simplify(BidIter p, BidIter q, OutIter out, double eps, std::input_iterator_tag)
+      {
+         std::vector<typename std::iterator_traits<BidIter>::value_type> pts(p, q);
+         return simplify(pts.begin(), pts.end(), out, eps, std::random_access_iterator_tag());
+      }
+
+      // convex hulls of the nodes of a segment tree over the vertices of a polyline.
+      // hershberger and snoeyink keep the path hulls in melkman deques, which are only
+      // hulls for simple chains; the tree is valid for any polyline. a hull is stored
+      // counterclockwise from its minimal vertex, nodes with one child share its hull
+      template <class RandIter>
+      class path_hull_tree
+      {
+         typedef typename std::iterator_traits<RandIter>::value_type point;
+
+         struct node
+         {
+            size_t begin, end, top;
+         };
+
+         point const & vertex(node const & nd, size_t k) const
+         {
+            return p_[verts_[nd.begin + k]];
+         }
+
+         // vertices of the hull of nd in lexicographical order
+         void sorted(node const & nd, std::vector<size_t> & out) const
+         {
+            size_t h = nd.end - nd.begin;
+            auto lower = verts_.begin() + nd.begin;
+            auto upper = verts_.rbegin() + (verts_.size() - nd.end);
+
+            std::merge(lower, lower + nd.top + 1, upper, upper + (h - nd.top - 1), std::back_inserter(out),
+                       [this] (size_t a, size_t b) { return p_[a] < p_[b]; });
+         }
+
+         // monotone chain of lexicographically sorted points, appended to verts_
+         node hull(std::vector<size_t> const & pts)
+         {
+            node res = {verts_.size(), verts_.size(), 0};
+
+            for (int pass = 0; pass != 2; ++pass)
+            {
+               size_t start = verts_.size();
+
+               for (size_t k = 0; k != pts.size(); ++k)
+               {
+                  size_t i = pass ? pts[pts.size() - k - 1] : pts[k];
+
+                  if (verts_.size() != start && p_[verts_.back()] == p_[i])
+                  {
+                     continue;
+                  }
+
+                  while (verts_.size() >= start + 2 && orientation(p_[verts_[verts_.size() - 2]], p_[verts_.back()], p_[i]) != CG_LEFT)
+                  {
+                     verts_.pop_back();
+                  }
+
+                  verts_.push_back(i);
+               }
+
+               verts_.pop_back();
+
+               if (pass == 0)
+               {
+                  res.top = verts_.size() - res.begin;
+               }
+            }
+
+            if (verts_.size() == res.begin)
+            {
+               // all the points are equal
+               verts_.push_back(pts.front());
+               res.top = 0;
+            }
+
+            res.end = verts_.size();
+            return res;
+         }
+
+         // vertex of the hull of nd extreme in the direction d, it is on the lower chain if
+         // d points down and on the upper one if d points up. d * edge decreases along it
+         std::pair<double, size_t> extreme(node const & nd, vector_2t<double> const & d) const
+         {
+            size_t h = nd.end - nd.begin;
+            size_t from = (d.y > 0) ? nd.top : 0;
+            size_t len = (d.y > 0) ? h - nd.top + 1 : nd.top + 1;
+
+            auto at = [&] (size_t k)
+            {
+               size_t pos = from + k;
+               return verts_[nd.begin + (pos == h ? 0 : pos)];
+            };
+
+            size_t lo = 0, hi = len - 1;
+
+            while (lo < hi)
+            {
+               size_t mid = (lo + hi) / 2;
+
+               if (d * (p_[at(mid + 1)] - p_[at(mid)]) > 0)
+               {
+                  lo = mid + 1;
+               }
+               else
+               {
+                  hi = mid;
+               }
+            }
+
+            point const & v = p_[at(lo)];
+            return std::make_pair(d * vector_2t<double>(v.x, v.y), at(lo));
+         }
+
+      public:
+         path_hull_tree(RandIter p, size_t n)
+            : p_(p)
+            , size_(1)
+         {
+            while (size_ < n)
+            {
+               size_ *= 2;
+            }
+
+            node empty = {0, 0, 0};
+            nodes_.assign(2 * size_, empty);
+
+            for (size_t i = 0; i != n; ++i)
+            {
+               node leaf = {verts_.size(), verts_.size() + 1, 0};
+               verts_.push_back(i);
+               nodes_[size_ + i] = leaf;
+            }
+
+            std::vector<size_t> pts;
+
+            for (size_t k = size_ - 1; k != 0; --k)
+            {
+               node const & l = nodes_[2 * k], & r = nodes_[2 * k + 1];
+
+               if (r.begin == r.end)
+               {
+                  nodes_[k] = l;
+                  continue;
+               }
+
+               pts.clear();
+               sorted(l, pts);
+               sorted(r, pts);
+               std::inplace_merge(pts.begin(), pts.begin() + (l.end - l.begin), pts.end(),
+                                  [this] (size_t a, size_t b) { return p_[a] < p_[b]; });
+
+               nodes_[k] = hull(pts);
+            }
+         }
+
+         // the first vertex in (i, j) farthest from the line through the vertices i and j
+         // (from the vertex i if they are equal) and the square of its distance. the hulls
+         // drop collinear and equal points, so the first of the tied vertices is found by
+         // descending from the first node reaching the maximum to its leftmost such leaf
+         std::pair<double, size_t> farthest(size_t i, size_t j) const
+         {
+            point const & a = p_[i], & b = p_[j];
+            vector_2t<double> v(b.x - a.x, b.y - a.y);
+            vector_2t<double> n(-v.y, v.x);
+            double vv = v * v, base = n * vector_2t<double>(a.x, a.y);
+
+            auto key = [&] (size_t k)
+            {
+               node const & nd = nodes_[k];
+               double res = -1;
+
+               for (size_t t = 0; vv == 0 && t != nd.end - nd.begin; ++t)
+               {
+                  auto w = vertex(nd, t) - a;
+                  res = std::max(res, double(w * w));
+               }
+
+               for (double sign : {1., -1.})
+               {
+                  if (vv != 0 && nd.begin != nd.end)
+                  {
+                     double c = extreme(nd, sign * n).first - sign * base;
+                     res = std::max(res, c * c / vv);
+                  }
+               }
+
+               return res;
+            };
+
+            // the nodes covering (i, j) from left to right
+            std::vector<size_t> & cover = cover_;
+            cover.clear();
+            size_t middle = 0;
+
+            for (size_t l = i + 1 + size_, r = j + size_; l < r; l /= 2, r /= 2)
+            {
+               if (l & 1)
+               {
+                  cover.insert(cover.begin() + middle++, l++);
+               }
+
+               if (r & 1)
+               {
+                  cover.insert(cover.begin() + middle, --r);
+               }
+            }
+
+            std::vector<double> & keys = keys_;
+            keys.clear();
+
+            for (size_t k : cover)
+            {
+               keys.push_back(key(k));
+            }
+
+            auto best = std::max_element(keys.begin(), keys.end());
+
+            if (best == keys.end() || *best < 0)
+            {
+               return std::make_pair(-1., j);
+            }
+
+            size_t k = cover[best - keys.begin()];
+
+            // the larger child if the maximum is lost to rounding
+            while (k < size_)
+            {
+               k = (key(2 * k) >= std::min(*best, key(2 * k + 1))) ? 2 * k : 2 * k + 1;
+            }
+
+            return std::make_pair(*best, k - size_);
+         }
+
+      private:
+         RandIter p_;
+         size_t size_;
+         std::vector<node> nodes_;
+         std::vector<size_t> verts_;
+
+         // buffers of farthest
+         mutable std::vector<size_t> cover_;
+         mutable std::vector<double> keys_;
+      };
+   }
+
+   // douglas-peucker: the vertices of [p, q) kept with the tolerance eps are written to
+   // out, the first and the last ones always are. a vertex is kept if it is farther
+   // than eps from the segment between the kept vertices around it. the recursion is
+   // an explicit stack, O(n^2) in the worst case. ranges without random access are copied
+   template <class BidIter, class OutIter>
+   OutIter simplify(BidIter p, BidIter q, OutIter out, double eps)
+   {
+      return detail::simplify(p, q, out, eps, typename std::iterator_traits<BidIter>::iterator_category());
    }
 
-}
\ No newline at end of file
+   // douglas-peucker with the distances to the lines through the kept vertices (the
+   // classic definition) and the farthest vertex of a subchain found on the hulls of a
+   // segment tree over the polyline as in hershberger and snoeyink: O(n log^2 n) for
+   // any input. the result may differ from simplify above where a vertex is close to
+   // the line through its kept neighbours but not to the segment between them, ties
+   // are broken towards the first vertex in both
+   template <class RandIter, class OutIter>
+   OutIter simplify(RandIter p, RandIter q, OutIter out, double eps, path_hull_t)
+   {
+      size_t n = q - p;
+      detail::path_hull_tree<RandIter> tree(p, n);
+      std::vector<std::pair<size_t, size_t> > stack;
+
+      detail::douglas_peucker(n, detail::squared_threshold(eps),
+                              [&tree] (size_t a, size_t b) { return tree.farthest(a, b); },
+                              [p, &out] (size_t i) { *out++ = p[i]; },
+                              stack);
+
+      return out;
+   }
+}
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+#include <cg/primitives/point.h>
+#include <cg/primitives/contour.h>
+#include <cg/primitives/triangle.h>
+#include <cg/operations/contains/triangle_point.h>
+#include <cg/operations/simplify.h>
+
+namespace cg
+{
+   namespace detail
+   {
+      // kd-tree over a fixed set of points from which points can be erased. the tree is
+      // implicit: the node of [lo, hi) is the point at (lo + hi) / 2 split by x on even
+      // levels and by y on odd ones, alive_ of a node counts its points not erased yet
+      template <class Scalar>
+      class erasable_kd_tree
+      {
+         typedef point_2t<Scalar> point;
+
+         struct item
+         {
+            point pt;
+            size_t id;
+         };
+
+         static Scalar coord(point const & p, bool by_y)
+         {
+            return by_y ? p.y : p.x;
+         }
+
+         void build(size_t lo, size_t hi, bool by_y)
+         {
+            if (lo == hi)
+            {
+               return;
+            }
+
+            size_t mid = (lo + hi) / 2;
+            std::nth_element(items_.begin() + lo, items_.begin() + mid, items_.begin() + hi,
+                             [by_y] (item const & a, item const & b) { return coord(a.pt, by_y) < coord(b.pt, by_y); });
+
+            alive_[mid] = hi - lo;
+            build(lo, mid, !by_y);
+            build(mid + 1, hi, !by_y);
+         }
+
+         template <class Visitor>
+         bool visit(size_t lo, size_t hi, bool by_y, point const & min, point const & max, Visitor & v) const
+         {
+            if (lo == hi)
+            {
+               return false;
+            }
+
+            size_t mid = (lo + hi) / 2;
+
+            if (alive_[mid] == 0)
+            {
+               return false;
+            }
+
+            point const & p = items_[mid].pt;
+
+            if (!erased_[items_[mid].id] && min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y && v(items_[mid].id))
+            {
+               return true;
+            }
+
+            Scalar c = coord(p, by_y);
+
+            return (coord(min, by_y) <= c && visit(lo, mid, !by_y, min, max, v))
+                || (c <= coord(max, by_y) && visit(mid + 1, hi, !by_y, min, max, v));
+         }
+
+      public:
+         explicit erasable_kd_tree(std::vector<point> const & pts)
+            : items_(pts.size())
+            , alive_(pts.size())
+            , pos_(pts.size())
+            , erased_(pts.size(), false)
+         {
+            for (size_t i = 0; i != pts.size(); ++i)
+            {
+               items_[i].pt = pts[i];
+               items_[i].id = i;
+            }
+
+            build(0, items_.size(), false);
+
+            for (size_t i = 0; i != items_.size(); ++i)
+            {
+               pos_[items_[i].id] = i;
+            }
+         }
+
+         void erase(size_t id)
+         {
+            erased_[id] = true;
+
+            for (size_t lo = 0, hi = items_.size(), pos = pos_[id]; ; )
+            {
+               size_t mid = (lo + hi) / 2;
+               --alive_[mid];
+
+               if (pos == mid)
+               {
+                  break;
+               }
+
+               (pos < mid ? hi : lo) = (pos < mid ? mid : mid + 1);
+            }
+         }
+
+         // calls v with the ids of the points in the box [min, max] until it returns true,
+         // true if it did
+         template <class Visitor>
+         bool find(point const & min, point const & max, Visitor v) const
+         {
+            return visit(0, items_.size(), false, min, max, v);
+         }
+
+      private:
+         std::vector<item> items_;
+         std::vector<size_t> alive_, pos_;
+         std::vector<bool> erased_;
+      };
+   }
+
+   // simplification of a set of closed contours without new intersections: a vertex v is
+   // removed only if the triangle of v and its neighbours u and w contains no other
+   // remaining vertex of any contour (points equal to u or w aside). if the contours do
+   // not cross each other or themselves, a segment crossing uw would have to cross uv or
+   // vw otherwise, so the result does not cross either. a boundary shared by adjacent
+   // contours is simplified in all of them at once and stays shared.
+   //
+   // as in simplify, every removed vertex is within eps of the segment between the kept
+   // vertices around it: the bound for the segment uw is the larger of the bounds of uv
+   // and vw plus the distance from v to uw. vertices are removed from the smallest bound
+   // up, contours keep at least three vertices. the simplified contours are written to
+   // out in order.
+   //
+   // a triangle is checked on a kd-tree of the remaining vertices in O(sqrt(n) + k), k
+   // is the number of vertices in its bounding box. a blocked vertex is checked again
+   // only when its neighbours change or the vertex found in its triangle is removed, so
+   // there are O(n) checks besides the ones of the vertices removed
+   template <class InputIter, class OutIter>
+   OutIter simplify_contours(InputIter first, InputIter last, OutIter out, double eps)
+   {
+      typedef typename std::iterator_traits<InputIter>::value_type contour;
+      typedef typename std::iterator_traits<typename contour::const_iterator>::value_type point;
+      typedef typename point::scalar_type scalar;
+
+      std::vector<point> pts;
+      std::vector<size_t> offsets(1, 0);
+
+      for (; first != last; ++first)
+      {
+         pts.insert(pts.end(), first->begin(), first->end());
+         offsets.push_back(pts.size());
+      }
+
+      size_t n = pts.size();
+      size_t const none = size_t(-1);
+
+      // vertices of a contour are a cyclic list, err[v] bounds the distance of the
+      // removed vertices to the segment from v to next[v]
+      std::vector<size_t> prev(n), next(n), owner(n), stamp(n, 0), sizes;
+      std::vector<double> err(n, 0);
+      std::vector<bool> removed(n, false);
+
+      for (size_t k = 0; k + 1 != offsets.size(); ++k)
+      {
+         size_t from = offsets[k], to = offsets[k + 1];
+         sizes.push_back(to - from);
+
+         for (size_t i = from; i != to; ++i)
+         {
+            prev[i] = (i == from) ? to - 1 : i - 1;
+            next[i] = (i + 1 == to) ? from : i + 1;
+            owner[i] = k;
+         }
+      }
+
+      detail::erasable_kd_tree<scalar> tree(pts);
+
+      auto cost = [&] (size_t v)
+      {
+         double d = std::sqrt(detail::squared_distance_to_segment(pts[prev[v]], pts[next[v]], pts[v]));
+         return std::max(err[prev[v]], err[v]) + d;
+      };
+
+      // the copies of v in adjacent contours between the same vertices are removed
+      // along with it and collected to twins, other copies block v. a vertex blocking v
+      // is written to blocker
+      auto safe = [&] (size_t v, std::vector<size_t> & twins, size_t & blocker)
+      {
+         point const & a = pts[prev[v]], & b = pts[v], & c = pts[next[v]];
+         triangle_2t<scalar> t(a, b, c);
+
+         point min(std::min({a.x, b.x, c.x}), std::min({a.y, b.y, c.y}));
+         point max(std::max({a.x, b.x, c.x}), std::max({a.y, b.y, c.y}));
+
+         return !tree.find(min, max, [&] (size_t i)
+         {
+            if (i == v || pts[i] == a || pts[i] == c)
+            {
+               return false;
+            }
+
+            if (pts[i] == b)
+            {
+               point const & l = pts[prev[i]], & r = pts[next[i]];
+
+               if ((l == a && r == c) || (l == c && r == a))
+               {
+                  twins.push_back(i);
+                  return false;
+               }
+            }
+            else if (!contains(t, pts[i]))
+            {
+               return false;
+            }
+
+            blocker = i;
+            return true;
+         });
+      };
+
+      // (bound, vertex, stamp), outdated entries are skipped. a vertex blocked by the
+      // triangle test waits in the list of the blocking vertex (through waiting_next)
+      // and is queued again when that one is removed or its own neighbours change
+      typedef std::tuple<double, size_t, size_t> entry;
+      std::priority_queue<entry, std::vector<entry>, std::greater<entry> > queue;
+      std::vector<size_t> waiting(n, none), waiting_vertex, waiting_next, twins;
+
+      for (size_t v = 0; v != n; ++v)
+      {
+         queue.push(entry(cost(v), v, stamp[v]));
+      }
+
+      while (!queue.empty())
+      {
+         double c;
+         size_t v, s;
+         std::tie(c, v, s) = queue.top();
+         queue.pop();
+
+         if (c > eps)
+         {
+            break;
+         }
+
+         if (removed[v] || s != stamp[v] || sizes[owner[v]] <= 3)
+         {
+            continue;
+         }
+
+         twins.clear();
+         size_t blocker;
+
+         if (!safe(v, twins, blocker))
+         {
+            waiting_vertex.push_back(v);
+            waiting_next.push_back(waiting[blocker]);
+            waiting[blocker] = waiting_vertex.size() - 1;
+            continue;
+         }
+
+         twins.push_back(v);
+         double bound = c;
+         bool enough = true;
+
+         for (size_t x : twins)
+         {
+            bound = std::max(bound, cost(x));
+            enough = enough && sizes[owner[x]] > 3;
+         }
+
+         // a twin with a larger bound comes later
+         if (bound > eps || !enough)
+         {
+            continue;
+         }
+
+         for (size_t x : twins)
+         {
+            size_t u = prev[x], w = next[x];
+
+            removed[x] = true;
+            tree.erase(x);
+            --sizes[owner[x]];
+
+            next[u] = w;
+            prev[w] = u;
+            err[u] = bound;
+
+            for (size_t y : {u, w})
+            {
+               queue.push(entry(cost(y), y, ++stamp[y]));
+            }
+
+            for (size_t k = waiting[x]; k != none; k = waiting_next[k])
+            {
+               size_t y = waiting_vertex[k];
+
+               if (!removed[y])
+               {
+                  queue.push(entry(cost(y), y, ++stamp[y]));
+               }
+            }
+         }
+      }
+
+      for (size_t k = 0; k + 1 != offsets.size(); ++k)
+      {
+         contour res;
+
+         for (size_t i = offsets[k]; i != offsets[k + 1]; ++i)
+         {
+            if (!removed[i])
+            {
+               res.add_point(pts[i]);
+            }
+         }
+
+         *out++ = res;
+      }
+
+      return out;
+   }
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <cg/primitives/point.h>
+#include <cg/primitives/vector.h>
+
+namespace cg
+{
+   namespace detail
+   {
+      // binary min-heap of ids in [0, n) with keys, pos_ of an id is its place in the
+      // heap so that the key of any id in it can be changed in O(log n). ties are broken
+      // by the ids
+      class indexed_min_heap
+      {
+         bool less(size_t a, size_t b) const
+         {
+            return std::make_pair(key_[a], a) < std::make_pair(key_[b], b);
+         }
+
+         void place(size_t i, size_t id)
+         {
+            heap_[i] = id;
+            pos_[id] = i;
+         }
+
+         void sift_up(size_t i)
+         {
+            size_t id = heap_[i];
+
+            for (; i != 0 && less(id, heap_[(i - 1) / 2]); i = (i - 1) / 2)
+            {
+               place(i, heap_[(i - 1) / 2]);
+            }
+
+            place(i, id);
+         }
+
+         void sift_down(size_t i)
+         {
+            size_t id = heap_[i];
+
+            for (size_t c; (c = 2 * i + 1) < heap_.size(); i = c)
+            {
+               if (c + 1 < heap_.size() && less(heap_[c + 1], heap_[c]))
+               {
+                  ++c;
+               }
+
+               if (!less(heap_[c], id))
+               {
+                  break;
+               }
+
+               place(i, heap_[c]);
+            }
+
+            place(i, id);
+         }
+
+      public:
+         explicit indexed_min_heap(size_t n)
+            : pos_(n, size_t(-1))
+            , key_(n)
+         {}
+
+         bool empty() const
+         {
+            return heap_.empty();
+         }
+
+         bool contains(size_t id) const
+         {
+            return pos_[id] != size_t(-1);
+         }
+
+         size_t top() const
+         {
+            return heap_.front();
+         }
+
+         double key(size_t id) const
+         {
+            return key_[id];
+         }
+
+         void push(size_t id, double key)
+         {
+            key_[id] = key;
+            heap_.push_back(id);
+            sift_up(heap_.size() - 1);
+         }
+
+         void pop()
+         {
+            pos_[heap_.front()] = size_t(-1);
+            size_t last = heap_.back();
+            heap_.pop_back();
+
+            if (!heap_.empty())
+            {
+               place(0, last);
+               sift_down(0);
+            }
+         }
+
+         void update(size_t id, double key)
+         {
+            bool up = key < key_[id];
+            key_[id] = key;
+
+            if (up)
+            {
+               sift_up(pos_[id]);
+            }
+            else
+            {
+               sift_down(pos_[id]);
+            }
+         }
+
+      private:
+         std::vector<size_t> heap_, pos_;
+         std::vector<double> key_;
+      };
+
+      template <class Point>
+      double triangle_area(Point const & a, Point const & b, Point const & c)
+      {
+         return std::fabs(double((b - a) ^ (c - a))) / 2;
+      }
+
+      // visvalingam-whyatt on [p, p + n): removed(i, area) is called for the inner
+      // vertices in the order of removal with their effective areas. the area of a
+      // vertex is that of the triangle with its current neighbours, raised to the last
+      // removed one so that the areas do not decrease along the order
+      template <class RandIter, class Removed>
+      void visvalingam(RandIter p, size_t n, Removed removed)
+      {
+         if (n < 3)
+         {
+            return;
+         }
+
+         std::vector<size_t> prev(n), next(n);
+         indexed_min_heap heap(n);
+
+         for (size_t i = 1; i + 1 < n; ++i)
+         {
+            prev[i] = i - 1;
+            next[i] = i + 1;
+            heap.push(i, triangle_area(p[i - 1], p[i], p[i + 1]));
+         }
+
+         double last = 0;
+
+         while (!heap.empty())
+         {
+            size_t v = heap.top();
+            last = std::max(last, heap.key(v));
+            heap.pop();
+
+            removed(v, last);
+
+            size_t u = prev[v], w = next[v];
+            next[u] = w;
+            prev[w] = u;
+
+            if (heap.contains(u))
+            {
+               heap.update(u, std::max(last, triangle_area(p[prev[u]], p[u], p[w])));
+            }
+
+            if (heap.contains(w))
+            {
+               heap.update(w, std::max(last, triangle_area(p[u], p[w], p[next[w]])));
+            }
+         }
+      }
+   }
+
+   // effective areas of the vertices of [p, q) by visvalingam-whyatt in O(n log n), the
+   // ends get infinity. a vertex is removed at a threshold iff its area is at most it, so
+   // visvalingam_simplify with the areas gives any level of detail in O(n)
+   template <class RandIter, class AreaIter>
+   AreaIter visvalingam_areas(RandIter p, RandIter q, AreaIter areas)
+   {
+      size_t n = q - p;
+
+      for (size_t i = 0; i != n; ++i)
+      {
+         areas[i] = std::numeric_limits<double>::infinity();
+      }
+
+      detail::visvalingam(p, n, [&areas] (size_t i, double area) { areas[i] = area; });
+      return areas + n;
+   }
+
+   // the vertices of [p, q) with the effective areas from visvalingam_areas above
+   // min_area are written to out
+   template <class RandIter, class AreaIter, class OutIter>
+   OutIter visvalingam_simplify(RandIter p, RandIter q, AreaIter areas, OutIter out, double min_area)
+   {
+      for (; p != q; ++p, ++areas)
+      {
+         if (*areas > min_area)
+         {
+            *out++ = *p;
+         }
+      }
+
+      return out;
+   }
+
+   // visvalingam-whyatt: the vertices of [p, q) left after removing the ones with the
+   // smallest effective areas while they are at most min_area are written to out
+   template <class RandIter, class OutIter>
+   OutIter visvalingam_simplify(RandIter p, RandIter q, OutIter out, double min_area)
+   {
+      std::vector<double> areas(q - p);
+      visvalingam_areas(p, q, areas.begin());
+      return visvalingam_simplify(p, q, areas.begin(), out, min_area);
+   }
+
+   // progressive level of detail: the indices of the vertices of [p, q) from the most to
+   // the least important one, the ends come first. the first k indices sorted are the
+   // vertices of visvalingam-whyatt left with k vertices
+   template <class RandIter, class OutIter>
+   OutIter visvalingam_order(RandIter p, RandIter q, OutIter out)
+   {
+      size_t n = q - p;
+      std::vector<size_t> order;
+      order.reserve(n);
+
+      detail::visvalingam(p, n, [&order] (size_t i, double) { order.push_back(i); });
+
+      if (n != 0)
+      {
+         *out++ = 0;
+      }
+
+      if (n > 1)
+      {
+         *out++ = n - 1;
+      }
+
+      return std::copy(order.rbegin(), order.rend(), out);
+   }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "point.h"
+
+namespace cg
+{
+   template <class Scalar> struct circle_2t;
+   typedef circle_2t<double> circle_2;
+   typedef circle_2t<float> circle_2f;
+
+   template <class Scalar>
+   struct circle_2t
+   {
+      point_2t<Scalar> center;
+      Scalar radius;
+
+      circle_2t()
+         : radius(0)
+      {}
+
+      circle_2t(point_2t<Scalar> const & center, Scalar radius)
+         : center(center)
+         , radius(radius)
+      {}
+   };
+
+   template <class Scalar>
+   bool operator == (circle_2t<Scalar> const & a, circle_2t<Scalar> const & b)
+   {
+      return a.center == b.center && a.radius == b.radius;
+   }
+
+   template <class Scalar>
+   bool operator != (circle_2t<Scalar> const & a, circle_2t<Scalar> const & b)
+   {
+      return !(a == b);
+   }
+}
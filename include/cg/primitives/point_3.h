@@ -0,0 +1,106 @@
+#pragma once
+
+#include "vector_3.h"
+
+namespace cg
+{
+   template <class Scalar> struct point_3t;
+
+   typedef point_3t<double>   point_3;
+   typedef point_3t<float>    point_3f;
+   typedef point_3t<int>      point_3i;
+
+   template <class Scalar>
+   struct point_3t
+   {
+      typedef Scalar scalar_type;
+      Scalar x, y, z;
+
+      point_3t(Scalar x, Scalar y, Scalar z)
+         : x(x)
+         , y(y)
+         , z(z)
+      {}
+
+      template <class UScalar>
+      point_3t(point_3t<UScalar> const & o)
+         : x(o.x)
+         , y(o.y)
+         , z(o.z)
+      {}
+
+      point_3t()
+         : x(0)
+         , y(0)
+         , z(0)
+      {}
+
+      point_3t<Scalar> & operator += (vector_3t<Scalar> const & delta)
+      {
+         x += delta.x;
+         y += delta.y;
+         z += delta.z;
+         return *this;
+      }
+   };
+
+   template <class Scalar>
+   inline bool operator < (point_3t<Scalar> const & a, point_3t<Scalar> const & b)
+   {
+      if (a.x != b.x)
+      {
+         return a.x < b.x;
+      }
+
+      if (a.y != b.y)
+      {
+         return a.y < b.y;
+      }
+
+      return a.z < b.z;
+   }
+
+   template <class Scalar>
+   bool operator > (point_3t<Scalar> const & a, point_3t<Scalar> const & b)
+   {
+      return b < a;
+   }
+
+   template <class Scalar>
+   bool operator == (point_3t<Scalar> const & a, point_3t<Scalar> const & b)
+   {
+      return (a.x == b.x) && (a.y == b.y) && (a.z == b.z);
+   }
+
+   template <class Scalar>
+   bool operator <= (point_3t<Scalar> const & a, point_3t<Scalar> const & b)
+   {
+      return !(a > b);
+   }
+
+   template <class Scalar>
+   bool operator >= (point_3t<Scalar> const & a, point_3t<Scalar> const & b)
+   {
+      return !(a < b);
+   }
+
+   template <class Scalar>
+   bool operator != (point_3t<Scalar> const & a, point_3t<Scalar> const & b)
+   {
+      return !(a == b);
+   }
+
+   template <class Scalar>
+   vector_3t<Scalar> const operator - (point_3t<Scalar> const & a, point_3t<Scalar> const & b)
+   {
+      return vector_3t<Scalar>(a.x - b.x, a.y - b.y, a.z - b.z);
+   }
+
+   template <class Scalar>
+   point_3t<Scalar> const operator + (point_3t<Scalar> const & pt, vector_3t<Scalar> const & delta)
+   {
+      point_3t<Scalar> res(pt);
+      res += delta;
+      return res;
+   }
+}
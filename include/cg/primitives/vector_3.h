@@ -0,0 +1,63 @@
+#pragma once
+
+namespace cg
+{
+   template <class Scalar> struct vector_3t;
+   typedef vector_3t<double> vector_3;
+   typedef vector_3t<float>  vector_3f;
+   typedef vector_3t<int>    vector_3i;
+
+   template <class Scalar>
+   struct vector_3t
+   {
+      Scalar x, y, z;
+
+      vector_3t<Scalar> & operator *= (Scalar s)
+      {
+         x *= s;
+         y *= s;
+         z *= s;
+
+         return *this;
+      }
+
+      vector_3t(Scalar x, Scalar y, Scalar z)
+         : x(x)
+         , y(y)
+         , z(z)
+      {}
+   };
+
+   // cross product
+   template <class Scalar>
+   vector_3t<Scalar> operator ^ (vector_3t<Scalar> const & v1, vector_3t<Scalar> const & v2)
+   {
+      return vector_3t<Scalar>(v1.y * v2.z - v1.z * v2.y,
+                               v1.z * v2.x - v1.x * v2.z,
+                               v1.x * v2.y - v1.y * v2.x);
+   }
+
+   template <class Scalar>
+   Scalar operator * (vector_3t<Scalar> const & v1, vector_3t<Scalar> const & v2)
+   {
+      return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+   }
+
+   template <class Scalar>
+   vector_3t<Scalar> operator * (vector_3t<Scalar> v, Scalar s)
+   {
+      return v *= s;
+   }
+
+   template <class Scalar>
+   vector_3t<Scalar> operator * (Scalar s, vector_3t<Scalar> v)
+   {
+      return v *= s;
+   }
+
+   template <class Scalar>
+   vector_3t<Scalar> const operator - (vector_3t<Scalar> const & v)
+   {
+      return vector_3t<Scalar>(-v.x, -v.y, -v.z);
+   }
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include "cg/operations/orientation.h"
+#include "cg/primitives/triangle.h"
+#include "cg/primitives/contour.h"
+#include "cg/triangulation/delaunay_triangulation.h"
+
+#include <vector>
+#include <map>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace cg
+{
+   template <class Scalar>
+   class alpha_shape_2t;
+
+   typedef alpha_shape_2t<double> alpha_shape_2;
+
+   // alpha shape of a point set, built on top of its delaunay triangulation.
+   // face belongs to the alpha complex iff its circumradius is <= alpha,
+   // edge is a boundary edge iff exactly one of its faces belongs to the complex.
+   // edges not adjacent to any face of the complex (singular edges) are not reported.
+   template <class Scalar>
+   class alpha_shape_2t
+   {
+      typedef point_2t<Scalar> point;
+
+      struct face
+      {
+         std::array<size_t, 3> v;
+         double radius;
+      };
+
+      // directed so that the face with the smaller radius lies to the left
+      struct edge
+      {
+         size_t from, to;
+         double lo, hi;
+      };
+
+      static double circumradius(point const & a, point const & b, point const & c)
+      {
+         double cross = (b - a) ^ (c - a);
+
+         if (cross == 0)
+         {
+            return std::numeric_limits<double>::infinity();
+         }
+
+         auto ab = b - a, bc = c - b, ca = a - c;
+         return std::sqrt((ab * ab) * (bc * bc) * (ca * ca) / (4 * cross * cross));
+      }
+
+      size_t vertex_id(std::map<point, size_t> & ids, point const & p)
+      {
+         auto it = ids.find(p);
+
+         if (it != ids.end())
+         {
+            return it->second;
+         }
+
+         ids.insert(std::make_pair(p, points_.size()));
+         points_.push_back(p);
+         return points_.size() - 1;
+      }
+
+      void build(std::vector< triangle_2t<Scalar> > const & triangulation)
+      {
+         std::map<point, size_t> ids;
+         std::map<std::pair<size_t, size_t>, size_t> half_edges;
+
+         for (auto const & tr : triangulation)
+         {
+            face f;
+
+            for (size_t i = 0; i != 3; ++i)
+            {
+               f.v[i] = vertex_id(ids, tr[i]);
+            }
+
+            orientation_t orient = orientation(tr[0], tr[1], tr[2]);
+
+            if (orient == CG_COLLINEAR)
+            {
+               continue;
+            }
+
+            if (orient == CG_RIGHT)
+            {
+               std::swap(f.v[1], f.v[2]);
+            }
+
+            f.radius = circumradius(tr[0], tr[1], tr[2]);
+            faces_.push_back(f);
+
+            // every face is visited once, each edge is classified when its second face shows up
+            for (size_t i = 0; i != 3; ++i)
+            {
+               size_t a = f.v[i], b = f.v[(i + 1) % 3];
+               auto twin = half_edges.find(std::make_pair(b, a));
+
+               if (twin == half_edges.end())
+               {
+                  half_edges.insert(std::make_pair(std::make_pair(a, b), edges_.size()));
+                  edge e = {a, b, f.radius, std::numeric_limits<double>::infinity()};
+                  edges_.push_back(e);
+               }
+               else
+               {
+                  edge & e = edges_[twin->second];
+                  half_edges.erase(twin);
+
+                  if (f.radius < e.lo)
+                  {
+                     std::swap(e.from, e.to);
+                     e.hi = e.lo;
+                     e.lo = f.radius;
+                  }
+                  else
+                  {
+                     e.hi = f.radius;
+                  }
+               }
+            }
+         }
+
+         std::sort(faces_.begin(), faces_.end(), [] (face const & a, face const & b)
+         {
+            return a.radius < b.radius;
+         });
+
+         std::sort(edges_.begin(), edges_.end(), [] (edge const & a, edge const & b)
+         {
+            return a.lo < b.lo;
+         });
+
+         for (auto const & f : faces_)
+         {
+            if (spectrum_.empty() || spectrum_.back() != f.radius)
+            {
+               spectrum_.push_back(f.radius);
+            }
+         }
+      }
+
+      // among edges leaving v choose the first one clockwise from direction v -> u
+      size_t next_edge(size_t u, size_t v, std::vector<size_t> const & candidates,
+                       std::vector<edge const *> const & boundary) const
+      {
+         point const & pv = points_[v];
+         point const & pu = points_[u];
+
+         auto half = [&] (point const & a)
+         {
+            switch (orientation(pv, pu, a))
+            {
+            case CG_RIGHT:
+               return 0;
+            case CG_LEFT:
+               return 2;
+            default:
+               return 1;
+            }
+         };
+
+         size_t best = candidates.front();
+
+         for (size_t id : candidates)
+         {
+            point const & a = points_[boundary[id]->to];
+            point const & b = points_[boundary[best]->to];
+            int ha = half(a), hb = half(b);
+
+            if (ha < hb || (ha == hb && ha != 1 && orientation(pv, b, a) == CG_RIGHT))
+            {
+               best = id;
+            }
+         }
+
+         return best;
+      }
+
+   public:
+
+      explicit alpha_shape_2t(std::vector< triangle_2t<Scalar> > const & triangulation)
+      {
+         build(triangulation);
+      }
+
+      template <class InputIter>
+      alpha_shape_2t(InputIter p, InputIter q)
+      {
+         build(delaunay_triangulation(p, q));
+      }
+
+      // sorted distinct circumradii, the boundary changes only at these values
+      std::vector<double> const & spectrum() const
+      {
+         return spectrum_;
+      }
+
+      std::vector< triangle_2t<Scalar> > faces(double alpha) const
+      {
+         std::vector< triangle_2t<Scalar> > res;
+
+         for (auto it = faces_.begin(); it != faces_.end() && it->radius <= alpha; ++it)
+         {
+            res.push_back(triangle_2t<Scalar>(points_[it->v[0]], points_[it->v[1]], points_[it->v[2]]));
+         }
+
+         return res;
+      }
+
+      // outer boundaries are counterclockwise, holes are clockwise
+      std::vector< contour_2t<Scalar> > boundaries(double alpha) const
+      {
+         std::vector<edge const *> boundary;
+
+         for (auto it = edges_.begin(); it != edges_.end() && it->lo <= alpha; ++it)
+         {
+            if (alpha < it->hi)
+            {
+               boundary.push_back(&*it);
+            }
+         }
+
+         std::multimap<size_t, size_t> outgoing;
+
+         for (size_t i = 0; i != boundary.size(); ++i)
+         {
+            outgoing.insert(std::make_pair(boundary[i]->from, i));
+         }
+
+         std::vector<bool> used(boundary.size(), false);
+         std::vector< contour_2t<Scalar> > res;
+
+         for (size_t start = 0; start != boundary.size(); ++start)
+         {
+            if (used[start])
+            {
+               continue;
+            }
+
+            contour_2t<Scalar> c;
+
+            for (size_t cur = start; !used[cur]; )
+            {
+               used[cur] = true;
+               c.add_point(points_[boundary[cur]->from]);
+
+               std::vector<size_t> candidates;
+               auto range = outgoing.equal_range(boundary[cur]->to);
+
+               for (auto it = range.first; it != range.second; ++it)
+               {
+                  if (!used[it->second] || it->second == start)
+                  {
+                     candidates.push_back(it->second);
+                  }
+               }
+
+               if (candidates.empty())
+               {
+                  break;
+               }
+
+               cur = next_edge(boundary[cur]->from, boundary[cur]->to, candidates, boundary);
+            }
+
+            res.push_back(c);
+         }
+
+         return res;
+      }
+
+   private:
+      std::vector<point> points_;
+      std::vector<face> faces_;
+      std::vector<edge> edges_;
+      std::vector<double> spectrum_;
+   };
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "cg/triangulation/delaunay_triangulation.h"
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <vector>
+#include <cstdint>
+
+namespace cg
+{
+   template <class Scalar>
+   class concurrent_triangulation_2t;
+
+   typedef concurrent_triangulation_2t<double> concurrent_triangulation_2;
+
+   // delaunay triangulation for many readers and one writer (left-right scheme).
+   //
+   // two identical triangulations are kept. readers always use the one the read index
+   // points to and never wait. the writer updates the other one, switches the read index,
+   // waits until readers leave the old one and replays the update there.
+   // a batch passed to insert(p, q) becomes visible to readers all at once.
+   template <class Scalar>
+   class concurrent_triangulation_2t
+   {
+      typedef point_2t<Scalar> point;
+      typedef triangulatable_points_set_2t<Scalar> triangulation;
+
+      // readers of different threads count themselves in different cache lines
+      static const size_t STRIPES = 32;
+
+      struct alignas(64) counter
+      {
+         std::atomic<size_t> value;
+      };
+
+      class read_guard
+      {
+      public:
+         explicit read_guard(concurrent_triangulation_2t const & owner)
+            : counters_(owner.readers_)
+            , stripe_(std::hash<std::thread::id>()(std::this_thread::get_id()) % STRIPES)
+         {
+            for (;;)
+            {
+               instance_ = owner.read_index_.load(std::memory_order_seq_cst);
+               counters_[instance_][stripe_].value.fetch_add(1, std::memory_order_seq_cst);
+
+               if (owner.read_index_.load(std::memory_order_seq_cst) == instance_)
+               {
+                  break;
+               }
+
+               counters_[instance_][stripe_].value.fetch_sub(1, std::memory_order_release);
+            }
+         }
+
+         ~read_guard()
+         {
+            counters_[instance_][stripe_].value.fetch_sub(1, std::memory_order_release);
+         }
+
+         size_t instance() const
+         {
+            return instance_;
+         }
+
+      private:
+         std::array<std::array<counter, STRIPES>, 2> & counters_;
+         size_t stripe_;
+         size_t instance_;
+      };
+
+      void wait_for_readers(size_t instance) const
+      {
+         for (auto const & c : readers_[instance])
+         {
+            while (c.value.load(std::memory_order_acquire) != 0)
+            {
+               std::this_thread::yield();
+            }
+         }
+      }
+
+      // applies f to both instances, readers see the result after the first application
+      template <class Update>
+      void update(Update f)
+      {
+         std::lock_guard<std::mutex> lock(writer_);
+
+         size_t read = read_index_.load(std::memory_order_relaxed);
+         size_t write = 1 - read;
+
+         wait_for_readers(write);
+         f(instances_[write]);
+         read_index_.store(write, std::memory_order_seq_cst);
+
+         wait_for_readers(read);
+         f(instances_[read]);
+      }
+
+   public:
+
+      explicit concurrent_triangulation_2t(uint64_t seed = 0)
+         : instances_{{triangulation(seed), triangulation(seed)}}
+         , read_index_(0)
+      {
+         for (auto & instance : readers_)
+         {
+            for (auto & c : instance)
+            {
+               c.value.store(0);
+            }
+         }
+      }
+
+      // writer side, calls are serialized
+
+      bool insert(point const & p)
+      {
+         bool res = false;
+
+         update([&p, &res] (triangulation & t)
+         {
+            res = t.insert(p);
+         });
+
+         return res;
+      }
+
+      // the range is read once, so single pass iterators are fine
+      template <class InputIter>
+      void insert(InputIter p, InputIter q)
+      {
+         std::vector<point> const pts(p, q);
+
+         update([&pts] (triangulation & t)
+         {
+            for (point const & pt : pts)
+            {
+               t.insert(pt);
+            }
+         });
+      }
+
+      void clear()
+      {
+         update([] (triangulation & t)
+         {
+            t.clear();
+         });
+      }
+
+      // reader side, safe from any number of threads concurrently with the writer
+
+      boost::optional< triangle_2t<Scalar> > localize(point const & p) const
+      {
+         read_guard guard(*this);
+         return instances_[guard.instance()].localize(p);
+      }
+
+      size_t size() const
+      {
+         read_guard guard(*this);
+         return instances_[guard.instance()].size();
+      }
+
+      std::vector< triangle_2t<Scalar> > get_triangulation() const
+      {
+         read_guard guard(*this);
+         return instances_[guard.instance()].get_triangulation();
+      }
+
+      triangulation_stats stats() const
+      {
+         read_guard guard(*this);
+         return instances_[guard.instance()].stats();
+      }
+
+   private:
+      // localize of a triangulation does not modify it but is not marked const
+      mutable std::array<triangulation, 2> instances_;
+      std::atomic<size_t> read_index_;
+      mutable std::array<std::array<counter, STRIPES>, 2> readers_;
+      std::mutex writer_;
+   };
+}
@@ -10,8 +10,10 @@
 #include <iterator>
 #include <vector>
 #include <list>
-#include <random>
 #include <array>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <utility>
 #include <iostream>
 
@@ -23,6 +25,25 @@ namespace cg
 
    typedef triangulatable_points_set_2t<double> triangulatable_points_set_2;
 
+   struct triangulation_level_stats
+   {
+      size_t vertices;
+      size_t faces;
+      size_t infinite_faces;
+   };
+
+   struct triangulation_stats
+   {
+      // levels.front() is the triangulation itself, the rest is the hierarchy
+      std::vector<triangulation_level_stats> levels;
+      // estimate of memory held by nodes and faces of all levels
+      size_t bytes;
+      // exponential moving averages over the recent insertions
+      double walk_length;
+      double flips;
+      size_t infinite_faces;
+   };
+
    template <class Scalar>
    class triangulatable_points_set_2t
    {
@@ -35,8 +56,6 @@ namespace cg
       typedef typename std::list<my_node>::iterator node_iterator;
       typedef typename std::list<my_face>::iterator face_iterator;
 
-      static constexpr double P = 0.5;
-
       struct my_node
       {
          point p;
@@ -244,8 +263,10 @@ namespace cg
       {
          std::list<my_node> nodes;
          std::list<my_face> faces;
+         size_t inf_faces;
+         size_t flips;
 
-         layer()
+         layer() : inf_faces(0), flips(0)
          {
             my_node inf;
             inf.inf = true;
@@ -257,6 +278,26 @@ namespace cg
             return nodes.size() - 1;
          }
 
+         face_iterator add_face(const my_face & face)
+         {
+            faces.push_back(face);
+            inf_faces += face.inf();
+            return std::prev(faces.end());
+         }
+
+         void erase_face(face_iterator face)
+         {
+            inf_faces -= face->inf();
+            faces.erase(face);
+         }
+
+         void replace_face(face_iterator face, const my_face & new_face)
+         {
+            inf_faces -= face->inf();
+            inf_faces += new_face.inf();
+            *face = new_face;
+         }
+
          bool closer(std::pair<point, point> first, std::pair<point, point> second)
          {
             return compare_dist(first.first, first.second, second.first, second.second);
@@ -283,7 +324,8 @@ namespace cg
 
          }
 
-         face_iterator localize(const point & p, boost::optional<node_iterator> close_point)
+         // does not modify the layer, steps of the walk are added to steps
+         face_iterator localize(const point & p, boost::optional<node_iterator> close_point, size_t & steps)
          {
             if (!close_point)
             {
@@ -310,6 +352,7 @@ namespace cg
                      if (has_intersection(std::make_pair(*((*res)[i]), my_node(p)), std::make_pair(*((*res)[i + 1]), *((*res)[i + 2]))))
                      {
                         res = res->neighbors[i];
+                        ++steps;
                         //res->print();
                         break;
                      }
@@ -322,7 +365,7 @@ namespace cg
             }
          }
 
-         node_iterator find_closest(point p, boost::optional<node_iterator> close_point)
+         node_iterator find_closest(point p, boost::optional<node_iterator> close_point, size_t & steps)
          {
             if (size() < 2 || !close_point)
             {
@@ -351,7 +394,7 @@ namespace cg
             }
             else
             {
-               my_face face = *localize(p, close_point);
+               my_face face = *localize(p, close_point, steps);
 
                if (face.on_ray(p))
                {
@@ -399,10 +442,10 @@ namespace cg
 
          void two_points()
          {
-            faces.push_back({nodes.begin(), std::next(nodes.begin()), std::next(std::next(nodes.begin()))});
+            add_face({nodes.begin(), std::next(nodes.begin()), std::next(std::next(nodes.begin()))});
             auto f1 = std::prev(faces.end());
 
-            faces.push_back({nodes.begin(), std::next(std::next(nodes.begin())), std::next(nodes.begin())});
+            add_face({nodes.begin(), std::next(std::next(nodes.begin())), std::next(nodes.begin())});
             auto f2 = std::prev(faces.end());
 
             for (size_t i = 0; i != 3; ++i)
@@ -453,8 +496,9 @@ namespace cg
             my_face face2((*face)[neighbor_id + 1], opposite_point, (*face)[neighbor_id]);
             face1.set_neighbors(neighbor, neighbor->neighbors[(opposite + 2) % 3], face->neighbors[(neighbor_id + 1) % 3]);
             face2.set_neighbors(face, face->neighbors[(neighbor_id + 2) % 3], neighbor->neighbors[(opposite + 1) % 3]);
-            *face = face1;
-            *neighbor = face2;
+            replace_face(face, face1);
+            replace_face(neighbor, face2);
+            ++flips;
             notify_neighbors_and_nodes(face);
             notify_neighbors_and_nodes(neighbor);
             check(face);
@@ -508,10 +552,10 @@ namespace cg
          void split_face(node_iterator p, face_iterator face_iter)
          {
             my_face face = *face_iter;
-            faces.erase(face_iter);
-            faces.push_back({face[1], face[2], p});
-            faces.push_back({face[2], face[0], p});
-            faces.push_back({face[0], face[1], p});
+            erase_face(face_iter);
+            add_face({face[1], face[2], p});
+            add_face({face[2], face[0], p});
+            add_face({face[0], face[1], p});
          }
 
          void insert_into_face(node_iterator p, face_iterator face_iter)
@@ -524,9 +568,9 @@ namespace cg
 
                if ((orientation(face[i + 1]->p, face[i + 2]->p, p->p) == CG_COLLINEAR) && !collinear_are_ordered_along_line(face[i + 1]->p, p->p, face[i + 2]->p))
                {
-                  faces.push_back({face[i], face[i + 2], p});
+                  add_face({face[i], face[i + 2], p});
                   auto f1 = std::prev(faces.end());
-                  faces.push_back({face[i + 2], face[i], p});
+                  add_face({face[i + 2], face[i], p});
                   auto f2 = std::prev(faces.end());
                   f1->set_neighbors(f2, f2, face_iter);
                   notify_neighbors_and_nodes(f1);
@@ -549,7 +593,7 @@ namespace cg
             {
                if (iterators[i]->is_line())
                {
-                  faces.erase(iterators[i]);
+                  erase_face(iterators[i]);
                   auto opposite = face.neighbors[i];
                   my_face opposite_face = *opposite;
                   split_face(p, opposite);
@@ -574,7 +618,7 @@ namespace cg
                      std::cerr << "opposite_iterators[j]->is_line not found" << std::endl;
                   }
 
-                  faces.erase(opposite_iterators[j]);
+                  erase_face(opposite_iterators[j]);
 
                   opposite_iterators[(j + 1) % 3]->set_neighbors(opposite_iterators[(j + 2) % 3], iterators[(i + 2) % 3], opposite_face.neighbors[(j + 1) % 3]);
                   notify_neighbors_and_nodes(opposite_iterators[(j + 1) % 3]);
@@ -608,7 +652,7 @@ namespace cg
             }
          }
 
-         node_iterator insert(point p, boost::optional<node_iterator> close_point)
+         node_iterator insert(point p, boost::optional<node_iterator> close_point, size_t & steps)
          {
             nodes.push_back(my_node(p));
 
@@ -620,7 +664,7 @@ namespace cg
             {
                if (size() > 2)
                {
-                  auto face = localize(p, close_point);
+                  auto face = localize(p, close_point, steps);
                   insert_into_face(std::prev(nodes.end()), face);
                }
             }
@@ -645,24 +689,63 @@ namespace cg
 
       };
 
-      std::mt19937 generator;
-      std::uniform_real_distribution<> distribution;
+      static uint64_t mix(uint64_t h)
+      {
+         h ^= h >> 30;
+         h *= 0xbf58476d1ce4e5b9ULL;
+         h ^= h >> 27;
+         h *= 0x94d049bb133111ebULL;
+         h ^= h >> 31;
+         return h;
+      }
+
+      static uint64_t bits(Scalar x)
+      {
+         // -0 and +0 are the same point
+         x += Scalar(0);
+         uint64_t res = 0;
+         std::memcpy(&res, &x, std::min(sizeof(x), sizeof(res)));
+         return res;
+      }
 
-      bool random_bool()
+      // every bit is a fair coin, i-th bit decides if the point goes to level i + 1.
+      // coins depend only on the point and the seed, so the hierarchy does not
+      // depend on insertion order
+      uint64_t coins(point const & p) const
       {
-         return distribution(generator) < P;
+         return mix(seed_ ^ mix(bits(p.x) + 0x9e3779b97f4a7c15ULL) ^ mix(mix(bits(p.y))));
       }
 
+      // weight of the last insertion in the moving averages of stats()
+      static constexpr double RECENT_WEIGHT = 1. / 128;
+
+      size_t flips() const
+      {
+         size_t res = 0;
+
+         for (auto const & level : levels)
+         {
+            res += level.flips;
+         }
+
+         return res;
+      }
+
+      uint64_t seed_;
       std::vector<layer> levels;
+      double recent_walk_length_;
+      double recent_flips_;
 
    public:
 
-      triangulatable_points_set_2t() : levels(1)
+      explicit triangulatable_points_set_2t(uint64_t seed = 0)
+         : seed_(seed), levels(1), recent_walk_length_(0), recent_flips_(0)
       {
       }
 
       template <class InputIter>
-      triangulatable_points_set_2t(InputIter p, InputIter q) : levels(1)
+      triangulatable_points_set_2t(InputIter p, InputIter q, uint64_t seed = 0)
+         : seed_(seed), levels(1), recent_walk_length_(0), recent_flips_(0)
       {
          for (auto it = p; it != q; ++it)
          {
@@ -675,18 +758,71 @@ namespace cg
          return levels.front().size();
       }
 
+      uint64_t seed() const
+      {
+         return seed_;
+      }
+
+      // levels of the hierarchy, the first one is the triangulation itself
+      size_t levels_count() const
+      {
+         return levels.size();
+      }
+
+      std::vector<point> level_points(size_t level) const
+      {
+         std::vector<point> res;
+
+         for (auto const & node : levels[level].nodes)
+         {
+            if (!node.inf)
+            {
+               res.push_back(node.p);
+            }
+         }
+
+         return res;
+      }
+
       void clear()
       {
          levels.clear();
          levels.push_back(layer());
+         recent_walk_length_ = 0;
+         recent_flips_ = 0;
+      }
+
+      // O(number of levels), cheap enough to be polled
+      triangulation_stats stats() const
+      {
+         triangulation_stats res;
+         res.bytes = sizeof(*this) + levels.capacity() * sizeof(layer);
+
+         // list nodes carry two pointers besides the value
+         size_t node_bytes = sizeof(my_node) + 2 * sizeof(void *);
+         size_t face_bytes = sizeof(my_face) + 2 * sizeof(void *);
+
+         for (auto const & level : levels)
+         {
+            triangulation_level_stats s = {level.size(), level.faces.size(), level.inf_faces};
+            res.levels.push_back(s);
+            res.bytes += level.nodes.size() * node_bytes + level.faces.size() * face_bytes;
+         }
+
+         res.walk_length = recent_walk_length_;
+         res.flips = recent_flips_;
+         res.infinite_faces = levels.front().inf_faces;
+         return res;
       }
 
       bool insert(point p)
       {
          //std::cerr << "Inserting " << p.x << " " << p.y << std::endl;
+         size_t steps = 0;
+         size_t flips_before = flips();
          std::vector<node_iterator> closest(levels.size());
 
-         closest.back() = levels.back().find_closest(p, boost::none);
+         closest.back() = levels.back().find_closest(p, boost::none, steps);
 
          if (closest.back()->p == p && !closest.back()->inf)
          {
@@ -696,7 +832,7 @@ namespace cg
          for (int level = static_cast<int>(levels.size()) - 2; level != -1; --level)
          {
             //std::cerr << "Localising on level " << level << std::endl;
-            closest[level] = levels[level].find_closest(p, closest[level + 1]->prev_level_node);
+            closest[level] = levels[level].find_closest(p, closest[level + 1]->prev_level_node, steps);
 
             if (closest[level]->p == p && !closest[level]->inf)
             {
@@ -706,29 +842,34 @@ namespace cg
 
          //std::cerr << "Level is " << 0 << std::endl;
          //std::cerr << "On this level the closest point is " << closest.front()->p.x << " " << closest.front()->p.y << std::endl;
-         auto prev = levels.front().insert(p, closest.front());
+         auto prev = levels.front().insert(p, closest.front(), steps);
 
          size_t level = 1;
 
-         while (random_bool())
+         for (uint64_t c = coins(p); c & 1; c >>= 1)
          {
             if (level == levels.size())
             {
                //std::cerr << "Level is " << level << std::endl;
                levels.push_back(layer());
-               auto iter = levels.back().insert(p, boost::none);
+               auto iter = levels.back().insert(p, boost::none, steps);
                iter->prev_level_node = prev;
-               break;
+               prev = iter;
+               ++level;
+               continue;
             }
 
             //std::cerr << "Level is " << level << std::endl;
             //std::cerr << "On this level the closest point is " << closest[level]->p.x << " " << closest[level]->p.y << std::endl;
-            auto inserted = levels[level].insert(p, closest[level]);
+            auto inserted = levels[level].insert(p, closest[level], steps);
             inserted->prev_level_node = prev;
             prev = inserted;
             ++level;
          }
 
+         recent_walk_length_ += RECENT_WEIGHT * (double(steps) - recent_walk_length_);
+         recent_flips_ += RECENT_WEIGHT * (double(flips() - flips_before) - recent_flips_);
+
          return true;
       }
 
@@ -737,17 +878,19 @@ namespace cg
          return levels.front().get_triangulation();
       }
 
+      // does not modify the triangulation, so concurrent calls are safe while nobody inserts
       boost::optional< triangle_2t<Scalar> > localize(const point & p)
       {
+         size_t steps = 0;
          std::vector<node_iterator> closest(levels.size());
-         closest.back() = levels.back().find_closest(p, boost::none);
+         closest.back() = levels.back().find_closest(p, boost::none, steps);
 
          for (int level = static_cast<int>(levels.size()) - 2; level != -1; --level)
          {
-            closest[level] = levels[level].find_closest(p, closest[level + 1]->prev_level_node);
+            closest[level] = levels[level].find_closest(p, closest[level + 1]->prev_level_node, steps);
          }
 
-         auto res = levels.front().localize(p, closest.front());
+         auto res = levels.front().localize(p, closest.front(), steps);
 
          if (res->inf())
          {
@@ -0,0 +1,628 @@
+#pragma once
+
+#include "cg/operations/orientation.h"
+#include "cg/primitives/triangle.h"
+#include "cg/primitives/rectangle.h"
+#include "cg/operations/contains/circumcircle_point.h"
+
+#include <vector>
+#include <map>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cassert>
+
+namespace cg
+{
+   // out-of-core delaunay triangulation (streaming, with spatial finalization).
+   //
+   // bounds are split into a grid of cells. points are fed in any order (usually
+   // chunk by chunk), and once the caller knows that a cell will get no more points
+   // it calls finalize_cell. a triangle whose circumcircle is covered by finalized
+   // cells can not be destroyed by any future point, so it is written to out and
+   // forgotten together with the vertices no longer used by active triangles.
+   // memory is therefore bounded by the active front, not by the input size.
+   //
+   // every point must lie inside bounds and in a cell which is not finalized yet.
+   template <class Scalar, class OutIter>
+   class streaming_delaunay_2t
+   {
+      typedef point_2t<Scalar> point;
+
+      static const size_t INF = 0;
+      static const size_t FINAL = std::numeric_limits<size_t>::max();
+
+      struct vertex
+      {
+         point p;
+         size_t refs;
+      };
+
+      struct face
+      {
+         std::array<size_t, 3> v;
+         // neighbors[i] is opposite to v[i], FINAL if that face is already written
+         std::array<size_t, 3> neighbors;
+         size_t stamp;
+         bool alive;
+         bool in_cavity;
+      };
+
+   public:
+      streaming_delaunay_2t(rectangle_2t<Scalar> const & bounds, size_t cells_x, size_t cells_y, OutIter out)
+         : bounds_(bounds)
+         , cells_x_(cells_x)
+         , cells_y_(cells_y)
+         , finalized_(cells_x * cells_y, false)
+         , waiting_(cells_x * cells_y)
+         , out_(out)
+         , last_(FINAL)
+         , active_faces_(0)
+      {
+         vertex inf = {point(), 1};
+         vertices_.push_back(inf);
+      }
+
+      std::pair<size_t, size_t> cell(point const & p) const
+      {
+         return std::make_pair(cell_index(p.x, bounds_.x, cells_x_), cell_index(p.y, bounds_.y, cells_y_));
+      }
+
+      void insert(point const & p)
+      {
+         assert(bounds_.contains(p));
+         assert(!finalized_[cell(p).second * cells_x_ + cell(p).first]);
+
+         if (active_faces_ == 0)
+         {
+            start(p);
+         }
+         else
+         {
+            insert_point(p);
+         }
+      }
+
+      template <class InputIter>
+      void insert(InputIter p, InputIter q)
+      {
+         for (; p != q; ++p)
+         {
+            insert(*p);
+         }
+      }
+
+      void finalize_cell(size_t x, size_t y)
+      {
+         size_t id = y * cells_x_ + x;
+
+         if (finalized_[id])
+         {
+            return;
+         }
+
+         finalized_[id] = true;
+
+         std::vector< std::pair<size_t, size_t> > waiting;
+         waiting.swap(waiting_[id]);
+
+         for (auto const & w : waiting)
+         {
+            if (faces_[w.first].alive && faces_[w.first].stamp == w.second)
+            {
+               try_finalize(w.first);
+            }
+         }
+      }
+
+      // writes all remaining finite triangles, the triangulator is empty afterwards
+      OutIter flush()
+      {
+         for (size_t f = 0; f != faces_.size(); ++f)
+         {
+            if (faces_[f].alive && !infinite(f))
+            {
+               emit(f);
+            }
+         }
+
+         faces_.clear();
+         free_faces_.clear();
+         vertices_.resize(1);
+         free_vertices_.clear();
+         pending_.clear();
+         active_faces_ = 0;
+         last_ = FINAL;
+
+         for (auto & w : waiting_)
+         {
+            w.clear();
+         }
+
+         return out_;
+      }
+
+      size_t active_faces() const
+      {
+         return active_faces_;
+      }
+
+      size_t active_vertices() const
+      {
+         return vertices_.size() - 1 - free_vertices_.size() + pending_.size();
+      }
+
+   private:
+
+      static size_t cell_index(Scalar x, range_t<Scalar> const & r, size_t cells)
+      {
+         double t = (double(x) - r.inf) / (double(r.sup) - r.inf) * cells;
+
+         if (t < 0)
+         {
+            return 0;
+         }
+
+         return std::min(static_cast<size_t>(t), cells - 1);
+      }
+
+      bool infinite(size_t f) const
+      {
+         return faces_[f].v[0] == INF || faces_[f].v[1] == INF || faces_[f].v[2] == INF;
+      }
+
+      point const & pt(size_t v) const
+      {
+         return vertices_[v].p;
+      }
+
+      size_t new_vertex(point const & p)
+      {
+         vertex v = {p, 0};
+
+         if (free_vertices_.empty())
+         {
+            vertices_.push_back(v);
+            return vertices_.size() - 1;
+         }
+
+         size_t id = free_vertices_.back();
+         free_vertices_.pop_back();
+         vertices_[id] = v;
+         return id;
+      }
+
+      void release_vertex(size_t v)
+      {
+         if (v != INF && --vertices_[v].refs == 0)
+         {
+            free_vertices_.push_back(v);
+         }
+      }
+
+      size_t new_face(size_t a, size_t b, size_t c)
+      {
+         size_t id;
+
+         if (free_faces_.empty())
+         {
+            faces_.push_back(face());
+            faces_.back().stamp = 0;
+            id = faces_.size() - 1;
+         }
+         else
+         {
+            id = free_faces_.back();
+            free_faces_.pop_back();
+         }
+
+         face & f = faces_[id];
+         f.v = {{a, b, c}};
+         f.neighbors = {{FINAL, FINAL, FINAL}};
+         f.alive = true;
+         f.in_cavity = false;
+         ++f.stamp;
+
+         for (size_t v : f.v)
+         {
+            if (v != INF)
+            {
+               ++vertices_[v].refs;
+            }
+         }
+
+         ++active_faces_;
+         last_ = id;
+         return id;
+      }
+
+      void delete_face(size_t id)
+      {
+         face & f = faces_[id];
+         f.alive = false;
+
+         for (size_t v : f.v)
+         {
+            release_vertex(v);
+         }
+
+         free_faces_.push_back(id);
+         --active_faces_;
+      }
+
+      size_t index_of(size_t f, size_t neighbor) const
+      {
+         for (size_t i = 0; i != 3; ++i)
+         {
+            if (faces_[f].neighbors[i] == neighbor)
+            {
+               return i;
+            }
+         }
+
+         return 3;
+      }
+
+      void emit(size_t f)
+      {
+         face const & fc = faces_[f];
+         *out_++ = triangle_2t<Scalar>(pt(fc.v[0]), pt(fc.v[1]), pt(fc.v[2]));
+
+         for (size_t n : fc.neighbors)
+         {
+            if (n != FINAL)
+            {
+               faces_[n].neighbors[index_of(n, f)] = FINAL;
+            }
+         }
+
+         delete_face(f);
+      }
+
+      // registers the face in the first not finalized cell its circumcircle touches,
+      // or writes it out if there is no such cell
+      void try_finalize(size_t f)
+      {
+         if (infinite(f))
+         {
+            return;
+         }
+
+         point const & a = pt(faces_[f].v[0]);
+         point const & b = pt(faces_[f].v[1]);
+         point const & c = pt(faces_[f].v[2]);
+
+         double bx = double(b.x) - a.x, by = double(b.y) - a.y;
+         double cx = double(c.x) - a.x, cy = double(c.y) - a.y;
+         double d = 2 * (bx * cy - by * cx);
+
+         if (d == 0)
+         {
+            return;
+         }
+
+         double b2 = bx * bx + by * by, c2 = cx * cx + cy * cy;
+         double ux = (cy * b2 - by * c2) / d;
+         double uy = (bx * c2 - cx * b2) / d;
+         double r = std::sqrt(ux * ux + uy * uy);
+         r += r * 1e-9 + 1e-12;
+         double ox = a.x + ux, oy = a.y + uy;
+
+         double w = (double(bounds_.x.sup) - bounds_.x.inf) / cells_x_;
+         double h = (double(bounds_.y.sup) - bounds_.y.inf) / cells_y_;
+
+         double x0 = std::floor((ox - r - bounds_.x.inf) / w), x1 = std::floor((ox + r - bounds_.x.inf) / w);
+         double y0 = std::floor((oy - r - bounds_.y.inf) / h), y1 = std::floor((oy + r - bounds_.y.inf) / h);
+
+         size_t i0 = static_cast<size_t>(std::max(x0, 0.));
+         size_t i1 = static_cast<size_t>(std::min(x1, double(cells_x_ - 1)));
+         size_t j0 = static_cast<size_t>(std::max(y0, 0.));
+         size_t j1 = static_cast<size_t>(std::min(y1, double(cells_y_ - 1)));
+
+         if (x1 >= 0 && y1 >= 0 && x0 < double(cells_x_) && y0 < double(cells_y_))
+         {
+            for (size_t j = j0; j <= j1; ++j)
+            {
+               for (size_t i = i0; i <= i1; ++i)
+               {
+                  size_t id = j * cells_x_ + i;
+
+                  if (!finalized_[id])
+                  {
+                     waiting_[id].push_back(std::make_pair(f, faces_[f].stamp));
+                     return;
+                  }
+               }
+            }
+         }
+
+         emit(f);
+      }
+
+      bool conflict(size_t f, point const & p) const
+      {
+         face const & fc = faces_[f];
+
+         for (size_t i = 0; i != 3; ++i)
+         {
+            if (fc.v[i] == INF)
+            {
+               point const & a = pt(fc.v[(i + 1) % 3]);
+               point const & b = pt(fc.v[(i + 2) % 3]);
+
+               switch (orientation(a, b, p))
+               {
+               case CG_LEFT:
+                  return true;
+
+               case CG_RIGHT:
+                  return false;
+
+               default:
+                  return collinear_are_ordered_along_line(a, p, b) && p != a && p != b;
+               }
+            }
+         }
+
+         return circumcircle_contains(triangle_2(pt(fc.v[0]), pt(fc.v[1]), pt(fc.v[2])), p);
+      }
+
+      size_t locate(point const & p) const
+      {
+         size_t f = last_;
+
+         if (f != FINAL && faces_[f].alive && infinite(f))
+         {
+            for (size_t i = 0; i != 3; ++i)
+            {
+               if (faces_[f].v[i] == INF)
+               {
+                  f = faces_[f].neighbors[i];
+               }
+            }
+         }
+
+         if (f != FINAL && faces_[f].alive)
+         {
+            for (size_t steps = 0; steps <= active_faces_; ++steps)
+            {
+               face const & fc = faces_[f];
+
+               if (infinite(f))
+               {
+                  return f;
+               }
+
+               size_t next = f;
+
+               for (size_t i = 0; i != 3; ++i)
+               {
+                  if (orientation(pt(fc.v[(i + 1) % 3]), pt(fc.v[(i + 2) % 3]), p) == CG_RIGHT)
+                  {
+                     next = fc.neighbors[i];
+                     break;
+                  }
+               }
+
+               if (next == f)
+               {
+                  return f;
+               }
+
+               if (next == FINAL)
+               {
+                  break;
+               }
+
+               f = next;
+            }
+         }
+
+         // walk was blocked by the already written part, active front is small enough to scan
+         for (size_t id = 0; id != faces_.size(); ++id)
+         {
+            if (faces_[id].alive && conflict(id, p))
+            {
+               return id;
+            }
+         }
+
+         return FINAL;
+      }
+
+      void insert_point(point const & p)
+      {
+         size_t start = locate(p);
+
+         if (start == FINAL || !conflict(start, p))
+         {
+            return;
+         }
+
+         std::vector<size_t> cavity(1, start);
+         faces_[start].in_cavity = true;
+
+         for (size_t k = 0; k != cavity.size(); ++k)
+         {
+            face const & fc = faces_[cavity[k]];
+
+            for (size_t v : fc.v)
+            {
+               if (v != INF && pt(v) == p)
+               {
+                  for (size_t f : cavity)
+                  {
+                     faces_[f].in_cavity = false;
+                  }
+
+                  return;
+               }
+            }
+
+            for (size_t n : fc.neighbors)
+            {
+               if (n != FINAL && !faces_[n].in_cavity && conflict(n, p))
+               {
+                  faces_[n].in_cavity = true;
+                  cavity.push_back(n);
+               }
+            }
+         }
+
+         size_t pv = new_vertex(p);
+
+         // boundary edges of the cavity, directed so that the cavity lies to the left
+         struct boundary_edge
+         {
+            size_t a, b, outside;
+         };
+
+         std::vector<boundary_edge> boundary;
+
+         for (size_t f : cavity)
+         {
+            face const & fc = faces_[f];
+
+            for (size_t i = 0; i != 3; ++i)
+            {
+               size_t n = fc.neighbors[i];
+
+               if (n == FINAL || !faces_[n].in_cavity)
+               {
+                  boundary_edge e = {fc.v[(i + 1) % 3], fc.v[(i + 2) % 3], n};
+                  boundary.push_back(e);
+               }
+            }
+         }
+
+         std::map<size_t, size_t> starting_at;
+         std::vector<size_t> created;
+
+         for (auto const & e : boundary)
+         {
+            size_t g = new_face(e.a, e.b, pv);
+            faces_[g].neighbors[2] = e.outside;
+            starting_at[e.a] = g;
+            created.push_back(g);
+         }
+
+         for (size_t k = 0; k != boundary.size(); ++k)
+         {
+            size_t g = created[k];
+            size_t n = faces_[g].neighbors[2];
+
+            if (n != FINAL)
+            {
+               for (size_t i = 0; i != 3; ++i)
+               {
+                  size_t old = faces_[n].neighbors[i];
+
+                  if (old != FINAL && faces_[old].in_cavity)
+                  {
+                     face const & of = faces_[n];
+
+                     if (of.v[(i + 1) % 3] == boundary[k].b && of.v[(i + 2) % 3] == boundary[k].a)
+                     {
+                        faces_[n].neighbors[i] = g;
+                     }
+                  }
+               }
+            }
+
+            size_t next = starting_at[boundary[k].b];
+            faces_[g].neighbors[0] = next;
+            faces_[next].neighbors[1] = g;
+         }
+
+         for (size_t f : cavity)
+         {
+            faces_[f].in_cavity = false;
+            delete_face(f);
+         }
+
+         for (size_t g : created)
+         {
+            try_finalize(g);
+         }
+      }
+
+      // collects points until there are three non collinear ones
+      void start(point const & p)
+      {
+         for (auto const & q : pending_)
+         {
+            if (q == p)
+            {
+               return;
+            }
+         }
+
+         if (pending_.size() < 2 || orientation(pending_[0], pending_[1], p) == CG_COLLINEAR)
+         {
+            pending_.push_back(p);
+            return;
+         }
+
+         std::vector<point> rest(pending_.begin() + 2, pending_.end());
+         point a = pending_[0], b = pending_[1];
+         pending_.clear();
+
+         if (orientation(a, b, p) == CG_RIGHT)
+         {
+            std::swap(a, b);
+         }
+
+         std::array<size_t, 3> v = {{new_vertex(a), new_vertex(b), new_vertex(p)}};
+         size_t inner = new_face(v[0], v[1], v[2]);
+         std::array<size_t, 3> outer;
+
+         for (size_t i = 0; i != 3; ++i)
+         {
+            outer[i] = new_face(v[(i + 2) % 3], v[(i + 1) % 3], INF);
+            faces_[inner].neighbors[i] = outer[i];
+            faces_[outer[i]].neighbors[2] = inner;
+         }
+
+         for (size_t i = 0; i != 3; ++i)
+         {
+            // outer[i] = (v[i + 2], v[i + 1], inf)
+            faces_[outer[i]].neighbors[0] = outer[(i + 2) % 3];
+            faces_[outer[i]].neighbors[1] = outer[(i + 1) % 3];
+         }
+
+         for (size_t f : outer)
+         {
+            try_finalize(f);
+         }
+
+         try_finalize(inner);
+
+         for (auto const & q : rest)
+         {
+            insert_point(q);
+         }
+      }
+
+      rectangle_2t<Scalar> bounds_;
+      size_t cells_x_, cells_y_;
+      std::vector<bool> finalized_;
+      std::vector< std::vector< std::pair<size_t, size_t> > > waiting_;
+      OutIter out_;
+
+      std::vector<vertex> vertices_;
+      std::vector<size_t> free_vertices_;
+      std::vector<face> faces_;
+      std::vector<size_t> free_faces_;
+      std::vector<point> pending_;
+      size_t last_;
+      size_t active_faces_;
+   };
+
+   template <class Scalar, class OutIter>
+   streaming_delaunay_2t<Scalar, OutIter> streaming_delaunay(rectangle_2t<Scalar> const & bounds, size_t cells_x, size_t cells_y, OutIter out)
+   {
+      return streaming_delaunay_2t<Scalar, OutIter>(bounds, cells_x, cells_y, out);
+   }
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <boost/assign/list_of.hpp>
+
+#include <cg/primitives/point.h>
+#include <cg/primitives/contour.h>
+#include <cg/operations/orientation.h>
+#include <cg/operations/contains/contour_point.h>
+#include <cg/triangulation/alpha_shape.h>
+
+#include "random_utils.h"
+
+using cg::point_2;
+
+TEST(alpha_shape, simple)
+{
+   std::vector<point_2> pts = boost::assign::list_of(point_2(0, 0))
+                                                    (point_2(1, 0))
+                                                    (point_2(0, 1))
+                                                    (point_2(10, 10));
+
+   cg::alpha_shape_2 shape(pts.begin(), pts.end());
+
+   ASSERT_EQ(shape.spectrum().size(), 2);
+   EXPECT_LT(shape.spectrum()[0], shape.spectrum()[1]);
+
+   EXPECT_TRUE(shape.boundaries(0.1).empty());
+
+   auto small = shape.boundaries(1);
+   ASSERT_EQ(small.size(), 1);
+   EXPECT_EQ(small[0].size(), 3);
+   EXPECT_TRUE(cg::counterclockwise(small[0]));
+
+   auto big = shape.boundaries(100);
+   ASSERT_EQ(big.size(), 1);
+   EXPECT_EQ(big[0].size(), 4);
+   EXPECT_TRUE(cg::counterclockwise(big[0]));
+}
+
+TEST(alpha_shape, uniform)
+{
+   std::vector<point_2> pts = uniform_points(300);
+   cg::alpha_shape_2 shape(pts.begin(), pts.end());
+
+   auto hull = shape.boundaries(shape.spectrum().back());
+   ASSERT_EQ(hull.size(), 1);
+   EXPECT_TRUE(cg::counterclockwise(hull[0]));
+
+   for (point_2 const & p : pts)
+   {
+      EXPECT_TRUE(cg::contains(hull[0], p));
+   }
+
+   EXPECT_EQ(shape.faces(shape.spectrum().back()).size(), shape.faces(1e100).size());
+   EXPECT_TRUE(shape.faces(shape.spectrum().front() / 2).empty());
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <boost/assign/list_of.hpp>
+
+#include <iterator>
+#include <set>
+
+#include <cg/operations/closest_pair.h>
+#include <cg/operations/compare_dist.h>
+
+#include "random_utils.h"
+
+namespace
+{
+   template <class RandIter>
+   bool is_closest_pair(RandIter p, RandIter q, std::pair<RandIter, RandIter> const & res)
+   {
+      if (res.first == res.second || res.first == q || res.second == q)
+      {
+         return false;
+      }
+
+      for (RandIter a = p; a != q; ++a)
+      {
+         for (RandIter b = a + 1; b != q; ++b)
+         {
+            if (cg::compare_dist(*a, *b, *res.first, *res.second))
+            {
+               return false;
+            }
+         }
+      }
+
+      return true;
+   }
+
+   std::vector<cg::point_2> grid_points(size_t count, int side)
+   {
+      util::uniform_random_int<int> rand(0, side);
+      std::vector<cg::point_2> res(count);
+
+      for (cg::point_2 & p : res)
+      {
+         p = cg::point_2(rand(), rand());
+      }
+
+      return res;
+   }
+}
+
+TEST(closest_pair, simple)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = boost::assign::list_of(point_2(0, 0))
+                                                    (point_2(5, 5))
+                                                    (point_2(1, 3))
+                                                    (point_2(4, 4))
+                                                    (point_2(10, 0));
+
+   auto res = cg::closest_pair(pts.begin(), pts.end());
+   EXPECT_TRUE(is_closest_pair(pts.begin(), pts.end(), res));
+   EXPECT_EQ(std::set<size_t>(boost::assign::list_of(1)(3)),
+             std::set<size_t>(boost::assign::list_of(res.first - pts.begin())(res.second - pts.begin())));
+
+   EXPECT_TRUE(cg::closest_pair(pts.begin(), pts.begin() + 1) == std::make_pair(pts.begin() + 1, pts.begin() + 1));
+}
+
+TEST(closest_pair, uniform)
+{
+   for (size_t count : {2, 3, 10, 100, 1000, 3000})
+   {
+      std::vector<cg::point_2> pts = uniform_points(count);
+      EXPECT_TRUE(is_closest_pair(pts.begin(), pts.end(), cg::closest_pair(pts.begin(), pts.end())));
+
+      // duplicates and ties
+      pts = grid_points(count, 100);
+      EXPECT_TRUE(is_closest_pair(pts.begin(), pts.end(), cg::closest_pair(pts.begin(), pts.end())));
+   }
+}
+
+TEST(closest_pair, parallel)
+{
+   std::vector<cg::point_2> pts = uniform_points(100000);
+
+   auto seq = cg::closest_pair(pts.begin(), pts.end());
+
+   for (size_t threads : {2, 3, 8})
+   {
+      auto par = cg::parallel_closest_pair(pts.begin(), pts.end(), threads);
+      EXPECT_FALSE(cg::compare_dist(*seq.first, *seq.second, *par.first, *par.second));
+      EXPECT_FALSE(cg::compare_dist(*par.first, *par.second, *seq.first, *seq.second));
+   }
+
+   pts = grid_points(100000, 1000);
+   auto par = cg::parallel_closest_pair(pts.begin(), pts.end(), 4);
+   seq = cg::closest_pair(pts.begin(), pts.end());
+   EXPECT_FALSE(cg::compare_dist(*seq.first, *seq.second, *par.first, *par.second));
+   EXPECT_FALSE(cg::compare_dist(*par.first, *par.second, *seq.first, *seq.second));
+}
+
+TEST(closest_pair, pairs_closer_than)
+{
+   typedef std::set<std::pair<size_t, size_t> > pair_set;
+
+   std::vector<cg::point_2> uniform = uniform_points(2000), grid = grid_points(2000, 50);
+
+   for (std::vector<cg::point_2> const * pts : {&uniform, &grid})
+   {
+      for (double r : {0.5, 1., 5.})
+      {
+         std::vector<std::pair<size_t, size_t> > res;
+         cg::pairs_closer_than(pts->begin(), pts->end(), r, std::back_inserter(res));
+
+         pair_set expected;
+
+         for (size_t i = 0; i != pts->size(); ++i)
+         {
+            for (size_t j = i + 1; j != pts->size(); ++j)
+            {
+               cg::vector_2 v = (*pts)[j] - (*pts)[i];
+
+               if (v * v < r * r)
+               {
+                  expected.insert(std::make_pair(i, j));
+               }
+            }
+         }
+
+         EXPECT_EQ(expected.size(), res.size());
+         EXPECT_TRUE(expected == pair_set(res.begin(), res.end()));
+      }
+   }
+}
+
+TEST(closest_pair, pairs_closer_than_far_apart)
+{
+   std::vector<cg::point_2> pts = {cg::point_2(0, 0), cg::point_2(1e300, 1e300), cg::point_2(1e300, 1e300 + 1e290),
+                                   cg::point_2(0.5, 0), cg::point_2(-1e300, 3)};
+
+   std::vector<std::pair<size_t, size_t> > res;
+   cg::pairs_closer_than(pts.begin(), pts.end(), 1, std::back_inserter(res));
+
+   ASSERT_EQ(1u, res.size());
+   EXPECT_EQ(std::make_pair(size_t(0), size_t(3)), res[0]);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "cg/primitives/point.h"
+#include "cg/triangulation/concurrent_triangulation.h"
+#include "cg/io/point.h"
+
+#include <thread>
+#include <atomic>
+#include <iterator>
+#include <sstream>
+
+#include "random_utils.h"
+
+using cg::point_2;
+
+TEST(concurrent_triangulation, readers_and_writer)
+{
+   std::vector<point_2> pts = uniform_points(3000);
+   std::vector<point_2> queries = uniform_points(200);
+
+   cg::concurrent_triangulation_2 tr(42);
+   tr.insert(pts.begin(), pts.begin() + 100);
+
+   std::atomic<bool> done(false);
+   std::atomic<size_t> failures(0);
+   std::vector<std::thread> readers;
+
+   for (size_t i = 0; i != 4; ++i)
+   {
+      readers.push_back(std::thread([&tr, &queries, &done, &failures] ()
+      {
+         size_t last_size = 0;
+
+         while (!done)
+         {
+            size_t size = tr.size();
+
+            if (size < last_size)
+            {
+               ++failures;
+            }
+
+            last_size = size;
+
+            for (point_2 const & q : queries)
+            {
+               tr.localize(q);
+            }
+         }
+      }));
+   }
+
+   for (size_t i = 100; i < pts.size(); i += 100)
+   {
+      tr.insert(pts.begin() + i, pts.begin() + std::min(i + 100, pts.size()));
+   }
+
+   tr.insert(pts.front());
+   done = true;
+
+   for (auto & t : readers)
+   {
+      t.join();
+   }
+
+   EXPECT_EQ(failures, 0);
+   EXPECT_EQ(tr.size(), pts.size());
+
+   cg::triangulatable_points_set_2 sequential(pts.begin(), pts.end(), 42);
+   EXPECT_EQ(tr.get_triangulation().size(), sequential.get_triangulation().size());
+
+   for (point_2 const & q : queries)
+   {
+      EXPECT_TRUE(tr.localize(q) == sequential.localize(q));
+   }
+}
+
+TEST(concurrent_triangulation, single_pass_range)
+{
+   std::vector<point_2> pts = uniform_points(300);
+   std::stringstream stream;
+
+   for (point_2 const & p : pts)
+   {
+      stream << p << " ";
+   }
+
+   cg::concurrent_triangulation_2 tr;
+   tr.insert(std::istream_iterator<point_2>(stream), std::istream_iterator<point_2>());
+   EXPECT_EQ(pts.size(), tr.size());
+
+   // the next insert goes first to the other instance, it has to have the range too
+   tr.insert(point_2(1000, 1000));
+   EXPECT_EQ(pts.size() + 1, tr.size());
+}
@@ -4,9 +4,11 @@
 
 #include <boost/assign/list_of.hpp>
 
+#include <cg/common/constants.h>
 #include <cg/operations/contains/segment_point.h>
 #include <cg/operations/contains/triangle_point.h>
 #include <cg/operations/contains/contour_point.h>
+#include <cg/operations/contains/trapezoidal_map.h>
 #include <cg/convex_hull/graham.h>
 
 TEST(contains, triangle_point)
@@ -390,3 +392,125 @@ TEST(contains, non_convex_contour_point_test5)
    EXPECT_EQ(contains(tr, cg::point_2(4, -0.5)), true);
    EXPECT_EQ(contains(tr, cg::point_2(3.5, 0.001)), true);
 }
+
+namespace details
+{
+   // star-shaped around the origin, on the integer grid if step is 1
+   cg::contour_2 random_star(size_t count, double step)
+   {
+      util::uniform_random_int<int> rand(-20, 20);
+      std::vector<std::pair<double, cg::point_2> > v;
+
+      while (v.size() != count)
+      {
+         cg::point_2 p(rand() * step, rand() * step);
+
+         if (p != cg::point_2(0, 0))
+         {
+            v.push_back(std::make_pair(std::atan2(p.y, p.x), p));
+         }
+      }
+
+      std::sort(v.begin(), v.end());
+
+      std::vector<cg::point_2> pts;
+
+      for (size_t i = 0; i != v.size(); ++i)
+      {
+         double gap = (i + 1 == v.size() ? v[0].first + 2 * cg::pi : v[i + 1].first) - v[i].first;
+
+         // the origin has to stay in the kernel
+         if (gap >= cg::pi)
+         {
+            return cg::contour_2();
+         }
+
+         if (i == 0 || v[i].first != v[i - 1].first)
+         {
+            pts.push_back(v[i].second);
+         }
+      }
+
+      return cg::contour_2(pts);
+   }
+
+   void check_trapezoidal_map(cg::contour_2 const & c, uint64_t seed)
+   {
+      cg::trapezoidal_map_2 m(c, seed);
+
+      for (int x = -21; x <= 21; ++x)
+      {
+         for (int y = -21; y <= 21; ++y)
+         {
+            for (double d : {0., 0.5})
+            {
+               cg::point_2 q(x + d, y + d / 3);
+               ASSERT_EQ(cg::contains(c, q), m.contains(q)) << q.x << " " << q.y;
+            }
+         }
+      }
+   }
+}
+
+TEST(contains, trapezoidal_map)
+{
+   // degenerate: equal x, vertical edges, queries on the vertices and the edges
+   for (size_t i = 0; i != 300; ++i)
+   {
+      cg::contour_2 c = details::random_star(3 + i % 40, 1);
+
+      if (c.size() >= 3)
+      {
+         details::check_trapezoidal_map(c, i);
+
+         std::vector<cg::point_2> cw(c.begin(), c.end());
+         std::reverse(cw.begin(), cw.end());
+         details::check_trapezoidal_map(cg::contour_2(cw), i);
+      }
+   }
+
+   // a comb, not star-shaped
+   std::vector<cg::point_2> pts = boost::assign::list_of
+      (cg::point_2(-20, -20))(cg::point_2(20, -20))(cg::point_2(20, 20));
+
+   for (int x = 16; x >= -16; x -= 8)
+   {
+      pts.push_back(cg::point_2(x, 20));
+      pts.push_back(cg::point_2(x, -10));
+      pts.push_back(cg::point_2(x - 4, -10));
+      pts.push_back(cg::point_2(x - 4, 20));
+   }
+
+   pts.push_back(cg::point_2(-20, 20));
+   details::check_trapezoidal_map(cg::contour_2(pts), 0);
+}
+
+TEST(contains, trapezoidal_map_batch)
+{
+   cg::contour_2 c;
+
+   while (c.size() < 3)
+   {
+      c = details::random_star(1000, 0.1 + 1e-3);
+   }
+
+   std::vector<cg::point_2> qs = uniform_points(50000);
+   for (cg::point_2 & q : qs)
+   {
+      q.x /= 40;
+      q.y /= 40;
+   }
+
+   cg::trapezoidal_map_2 m(c);
+   std::vector<char> batch, parallel(qs.size());
+
+   m.contains(qs.begin(), qs.end(), std::back_inserter(batch));
+   m.parallel_contains(qs.begin(), qs.end(), parallel.begin(), 3);
+
+   EXPECT_EQ(batch, parallel);
+
+   for (size_t i = 0; i != qs.size(); i += 25)
+   {
+      ASSERT_EQ(cg::contains(c, qs[i]), bool(batch[i]));
+   }
+}
@@ -2,11 +2,23 @@
 
 #include <boost/assign/list_of.hpp>
 
+#include <sstream>
+#include <iterator>
+
+#include <cg/common/constants.h>
 #include <cg/convex_hull/graham.h>
 #include <cg/convex_hull/andrew.h>
 #include <cg/convex_hull/jarvis.h>
 #include <cg/operations/contains/segment_point.h>
 #include <cg/convex_hull/quick_hull.h>
+#include <cg/convex_hull/parallel_quick_hull.h>
+#include <cg/convex_hull/akl_toussaint.h>
+#include <cg/convex_hull/chan.h>
+#include <cg/convex_hull/dynamic_hull.h>
+#include <cg/convex_hull/streaming_hull.h>
+#include <cg/convex_hull/parallel_hull.h>
+#include <cg/convex_hull/melkman.h>
+#include <cg/io/point.h>
 
 #include "random_utils.h"
 
@@ -65,6 +77,35 @@ TEST(graham_hull, uniform)
    EXPECT_TRUE(is_convex_hull(pts.begin(), cg::graham_hull(pts.begin(), pts.end()), pts.end()));
 }
 
+TEST(graham_hull, pseudo_angle_sort)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = uniform_points(300000);
+
+   for (size_t i = 0; i < pts.size(); i += 2)
+   {
+      pts[i] = point_2(floor(pts[i].x), floor(pts[i].y));
+   }
+
+   for (size_t i = 0; i != 2000; ++i)
+   {
+      double angle = 2 * cg::pi * i / 2000;
+      pts.push_back(point_2(100 * cos(angle), 100 * sin(angle)));
+      pts.push_back(point_2(-100 + i * 1e-13, -100 + i * 3e-13));
+   }
+
+   for (size_t cnt : {0, 1, 2, 255, 256, 1000, 10000, 304000})
+   {
+      std::vector<point_2> a(pts.begin(), pts.begin() + cnt), b(a);
+
+      std::vector<point_2> expected(a.begin(), cg::graham_hull(a.begin(), a.end()));
+      auto hull_end = cg::graham_hull(b.begin(), b.end(), cg::pseudo_angle_sort);
+      EXPECT_EQ(expected, std::vector<point_2>(b.begin(), hull_end));
+      EXPECT_TRUE(is_convex_hull(b.begin(), hull_end, b.end()));
+   }
+}
+
 TEST(andrew_hull, simple)
 {
    using cg::point_2;
@@ -286,3 +327,485 @@ TEST(quick_hull, uniform)
    EXPECT_TRUE(is_convex_hull(pts.begin(), cg::quick_hull(pts.begin(), pts.end()), pts.end()));
 }
 
+TEST(parallel_quick_hull, uniform)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = uniform_points(1000000);
+   std::vector<point_2> copy(pts);
+
+   auto hull_end = cg::parallel_quick_hull(pts.begin(), pts.end(), 8);
+   EXPECT_TRUE(is_convex_hull(pts.begin(), hull_end, pts.end()));
+
+   std::vector<point_2> expected(copy.begin(), cg::quick_hull(copy.begin(), copy.end()));
+   std::vector<point_2> actual(pts.begin(), hull_end);
+   std::sort(expected.begin(), expected.end());
+   std::sort(actual.begin(), actual.end());
+   EXPECT_EQ(expected, actual);
+
+   std::sort(pts.begin(), pts.end());
+   std::sort(copy.begin(), copy.end());
+   EXPECT_EQ(copy, pts);
+}
+
+TEST(parallel_quick_hull, circle)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts;
+
+   for (size_t i = 0; i != 100000; ++i)
+   {
+      double angle = 2 * cg::pi * i / 100000;
+      pts.push_back(point_2(100 * cos(angle), 100 * sin(angle)));
+   }
+
+   std::random_shuffle(pts.begin(), pts.end());
+   std::vector<point_2> copy(pts);
+
+   std::vector<point_2> expected(copy.begin(), cg::quick_hull(copy.begin(), copy.end()));
+   std::vector<point_2> actual(pts.begin(), cg::parallel_quick_hull(pts.begin(), pts.end(), 4));
+   std::sort(expected.begin(), expected.end());
+   std::sort(actual.begin(), actual.end());
+   EXPECT_EQ(expected, actual);
+}
+
+TEST(akl_toussaint, filter)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = uniform_points(100000);
+   std::vector<point_2> copy(pts);
+
+   auto candidates_end = cg::akl_toussaint_filter(pts.begin(), pts.end());
+   EXPECT_LT(std::distance(pts.begin(), candidates_end), 20000);
+
+   std::vector<point_2> expected(copy.begin(), cg::andrew_hull(copy.begin(), copy.end()));
+   std::vector<point_2> actual(pts.begin(), cg::andrew_hull(pts.begin(), candidates_end));
+   std::sort(expected.begin(), expected.end());
+   std::sort(actual.begin(), actual.end());
+   EXPECT_EQ(expected, actual);
+}
+
+TEST(akl_toussaint, hulls)
+{
+   using cg::point_2;
+
+   for (size_t cnt : {1, 5, 9, 20, 100000})
+   {
+      std::vector<point_2> pts = uniform_points(cnt);
+
+      std::vector<point_2> a(pts);
+      EXPECT_TRUE(is_convex_hull(a.begin(), cg::graham_hull(a.begin(), a.end(), cg::akl_toussaint_prefilter), a.end()));
+
+      std::vector<point_2> b(pts);
+      EXPECT_TRUE(is_convex_hull(b.begin(), cg::andrew_hull(b.begin(), b.end(), cg::akl_toussaint_prefilter), b.end()));
+
+      std::vector<point_2> c(pts);
+      EXPECT_TRUE(is_convex_hull(c.begin(), cg::jarvis_hull(c.begin(), c.end(), cg::akl_toussaint_prefilter), c.end()));
+
+      std::vector<point_2> d(pts);
+      EXPECT_TRUE(is_convex_hull(d.begin(), cg::quick_hull(d.begin(), d.end(), cg::akl_toussaint_prefilter), d.end()));
+   }
+}
+
+TEST(akl_toussaint, same_line)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts;
+
+   for (int i = 0; i != 100; ++i)
+   {
+      pts.push_back(point_2(i, 2 * i));
+   }
+
+   std::random_shuffle(pts.begin(), pts.end());
+   EXPECT_EQ(cg::akl_toussaint_filter(pts.begin(), pts.end()), pts.end());
+   EXPECT_TRUE(is_convex_hull(pts.begin(), cg::andrew_hull(pts.begin(), pts.end(), cg::akl_toussaint_prefilter), pts.end()));
+}
+
+TEST(chan_hull, uniform)
+{
+   using cg::point_2;
+
+   for (size_t cnt : {1, 2, 3, 15, 16, 17, 100, 1000, 200000})
+   {
+      std::vector<point_2> pts = uniform_points(cnt);
+      std::vector<point_2> copy(pts);
+
+      auto hull_end = cg::chan_hull(pts.begin(), pts.end());
+      EXPECT_TRUE(is_convex_hull(pts.begin(), hull_end, pts.end()));
+
+      std::vector<point_2> expected(copy.begin(), cg::andrew_hull(copy.begin(), copy.end()));
+      EXPECT_EQ(expected, std::vector<point_2>(pts.begin(), hull_end));
+
+      std::sort(pts.begin(), pts.end());
+      std::sort(copy.begin(), copy.end());
+      EXPECT_EQ(copy, pts);
+   }
+}
+
+TEST(chan_hull, degenerate)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts;
+   int sz = 30;
+
+   for (int i = 0; i < sz; i++)
+   {
+      for (int j = 0; j < sz; j++)
+      {
+         pts.push_back(point_2(i, j));
+         pts.push_back(point_2(i, j));
+      }
+   }
+
+   for (int it = 0; it < 5; ++it)
+   {
+      std::random_shuffle(pts.begin(), pts.end());
+      auto hull_end = cg::chan_hull(pts.begin(), pts.end());
+      EXPECT_TRUE(is_convex_hull(pts.begin(), hull_end, pts.end()));
+      EXPECT_EQ(std::distance(pts.begin(), hull_end), 4);
+   }
+
+   std::vector<point_2> circle;
+
+   for (size_t i = 0; i != 5000; ++i)
+   {
+      double angle = 2 * cg::pi * i / 5000;
+      circle.push_back(point_2(100 * cos(angle), 100 * sin(angle)));
+   }
+
+   std::random_shuffle(circle.begin(), circle.end());
+   std::vector<point_2> copy(circle);
+   std::vector<point_2> expected(copy.begin(), cg::andrew_hull(copy.begin(), copy.end()));
+   EXPECT_EQ(expected, std::vector<point_2>(circle.begin(), cg::chan_hull(circle.begin(), circle.end())));
+}
+
+namespace
+{
+   // tangent from q found by a scan, q is outside of the hull of pts
+   cg::point_2 tangent_scan(std::vector<cg::point_2> const & pts, cg::point_2 const & q, cg::orientation_t side)
+   {
+      cg::point_2 res = pts.front();
+
+      for (cg::point_2 const & p : pts)
+      {
+         cg::orientation_t o = orientation(q, res, p);
+
+         if (o == side || (o == cg::CG_COLLINEAR && collinear_are_ordered_along_line(q, res, p)))
+         {
+            res = p;
+         }
+      }
+
+      return res;
+   }
+}
+
+TEST(dynamic_hull, insert_erase)
+{
+   using cg::point_2;
+
+   for (bool grid : {false, true})
+   {
+      std::vector<point_2> pts = uniform_points(2000);
+
+      if (grid)
+      {
+         for (point_2 & p : pts)
+         {
+            p = point_2(floor(p.x / 20), floor(p.y / 20));
+         }
+      }
+
+      cg::dynamic_hull_2 hull;
+      std::vector<point_2> current;
+
+      for (size_t i = 0; i != pts.size(); ++i)
+      {
+         bool inserted = std::find(current.begin(), current.end(), pts[i]) == current.end();
+         EXPECT_EQ(inserted, hull.insert(pts[i]));
+
+         if (inserted)
+         {
+            current.push_back(pts[i]);
+         }
+
+         // erase a random point every third step
+         if (i % 3 == 2)
+         {
+            size_t k = (i * 7919) % current.size();
+            EXPECT_TRUE(hull.erase(current[k]));
+            EXPECT_FALSE(hull.erase(current[k]));
+            current.erase(current.begin() + k);
+         }
+
+         ASSERT_EQ(current.size(), hull.size());
+
+         if (i % 50 == 0 || i + 1 == pts.size())
+         {
+            std::vector<point_2> copy(current);
+            std::vector<point_2> expected(copy.begin(), cg::andrew_hull(copy.begin(), copy.end()));
+            EXPECT_EQ(expected, hull.hull());
+         }
+      }
+
+      while (!current.empty())
+      {
+         EXPECT_TRUE(hull.erase(current.back()));
+         current.pop_back();
+      }
+
+      EXPECT_TRUE(hull.empty());
+      EXPECT_TRUE(hull.hull().empty());
+   }
+}
+
+TEST(dynamic_hull, queries)
+{
+   using cg::point_2;
+
+   for (bool grid : {false, true})
+   {
+      std::vector<point_2> pts = uniform_points(3000);
+
+      if (grid)
+      {
+         for (point_2 & p : pts)
+         {
+            p = point_2(floor(p.x / 10), floor(p.y / 10));
+         }
+      }
+
+      std::vector<point_2> queries(pts.begin() + 1000, pts.end());
+      pts.resize(1000);
+
+      cg::dynamic_hull_2 hull;
+
+      for (point_2 const & p : pts)
+      {
+         hull.insert(p);
+      }
+
+      std::vector<point_2> copy(pts);
+      std::vector<point_2> ch(copy.begin(), cg::andrew_hull(copy.begin(), copy.end()));
+
+      for (point_2 const & q : queries)
+      {
+         point_2 dir = grid ? point_2(q.x, q.y) : point_2(q.x - 1, q.y + 2);
+         cg::vector_2 d(dir.x, dir.y);
+         auto e = hull.extreme(d);
+         ASSERT_TRUE(e);
+
+         for (point_2 const & p : pts)
+         {
+            EXPECT_LE(d.x * p.x + d.y * p.y, d.x * e->x + d.y * e->y);
+         }
+
+         point_2 far(q.x * 1.5, q.y * 1.5);
+
+         for (point_2 const & r : {q, far})
+         {
+            bool outside = false;
+
+            for (size_t i = 0, j = ch.size() - 1; i != ch.size(); j = i++)
+            {
+               outside = outside || orientation(ch[j], ch[i], r) == cg::CG_RIGHT;
+            }
+
+            EXPECT_EQ(!outside, hull.contains(r));
+
+            auto t = hull.tangents(r);
+            EXPECT_EQ(outside, bool(t));
+
+            if (t)
+            {
+               EXPECT_EQ(tangent_scan(pts, r, cg::CG_RIGHT), t->first);
+               EXPECT_EQ(tangent_scan(pts, r, cg::CG_LEFT), t->second);
+            }
+         }
+      }
+   }
+}
+
+TEST(streaming_hull, uniform)
+{
+   using cg::point_2;
+
+   for (bool grid : {false, true})
+   {
+      std::vector<point_2> pts = uniform_points(100000);
+
+      if (grid)
+      {
+         for (point_2 & p : pts)
+         {
+            p = point_2(floor(p.x / 10), floor(p.y / 10));
+         }
+      }
+
+      std::stringstream stream;
+      stream.precision(17);
+
+      for (point_2 const & p : pts)
+      {
+         stream << p << " ";
+      }
+
+      std::vector<point_2> res;
+      cg::streaming_hull(std::istream_iterator<point_2>(stream), std::istream_iterator<point_2>(), std::back_inserter(res));
+
+      std::sort(pts.begin(), pts.end());
+      pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+      std::vector<point_2> expected(pts.begin(), cg::andrew_hull(pts.begin(), pts.end()));
+      EXPECT_EQ(expected, res);
+   }
+}
+
+TEST(streaming_hull, merge)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = uniform_points(10000);
+   std::vector<cg::streaming_hull_2> streams(7);
+
+   for (size_t i = 0; i != pts.size(); ++i)
+   {
+      streams[i % streams.size()].insert(pts[i]);
+
+      if (i % 1000 == 0)
+      {
+         std::vector<point_2> part;
+
+         for (size_t j = i % streams.size(); j <= i; j += streams.size())
+         {
+            part.push_back(pts[j]);
+         }
+
+         std::vector<point_2> expected(part.begin(), cg::andrew_hull(part.begin(), part.end()));
+         EXPECT_EQ(expected, streams[i % streams.size()].hull());
+         EXPECT_EQ(expected.size(), streams[i % streams.size()].size());
+      }
+   }
+
+   for (size_t i = 1; i != streams.size(); ++i)
+   {
+      streams.front().merge(streams[i]);
+   }
+
+   std::vector<point_2> expected(pts.begin(), cg::andrew_hull(pts.begin(), pts.end()));
+   EXPECT_EQ(expected, streams.front().hull());
+
+   cg::streaming_hull_2 line;
+   line.insert(point_2(1, 1));
+   EXPECT_EQ(1u, line.size());
+   line.insert(point_2(3, 3));
+   line.insert(point_2(2, 2));
+   line.insert(point_2(0, 0));
+   EXPECT_EQ(std::vector<point_2>({point_2(0, 0), point_2(3, 3)}), line.hull());
+}
+
+TEST(parallel_hull, backends)
+{
+   using cg::point_2;
+   typedef std::vector<point_2>::iterator iter;
+
+   std::vector<point_2> pts = uniform_points(200000);
+
+   for (size_t i = 0; i < pts.size(); i += 3)
+   {
+      pts[i] = point_2(floor(pts[i].x), floor(pts[i].y));
+   }
+
+   std::vector<point_2> copy(pts);
+   std::vector<point_2> expected(copy.begin(), cg::andrew_hull(copy.begin(), copy.end()));
+
+   for (size_t threads : {1, 2, 3, 8})
+   {
+      std::vector<point_2> a(pts), g(pts), j(pts);
+
+      EXPECT_EQ(expected, std::vector<point_2>(a.begin(), cg::parallel_hull(a.begin(), a.end(), threads)));
+
+      auto graham_end = cg::parallel_hull(g.begin(), g.end(), [] (iter p, iter q) { return cg::graham_hull(p, q); }, threads);
+      EXPECT_EQ(expected, std::vector<point_2>(g.begin(), graham_end));
+
+      auto quick_end = cg::parallel_hull(j.begin(), j.end(), [] (iter p, iter q) { return cg::quick_hull(p, q); }, threads);
+      EXPECT_EQ(expected, std::vector<point_2>(j.begin(), quick_end));
+
+      std::sort(a.begin(), a.end());
+      std::sort(copy.begin(), copy.end());
+      EXPECT_EQ(copy, a);
+   }
+}
+
+TEST(melkman_hull, simple_polygons)
+{
+   using cg::point_2;
+
+   util::uniform_random_real<double> rand(0., 1.);
+
+   for (size_t cnt : {1, 2, 3, 4, 10, 100, 10000})
+   {
+      // star shaped polygon around the origin
+      std::vector<double> angles(cnt);
+
+      for (double & a : angles)
+      {
+         rand >> a;
+         a *= 2 * cg::pi;
+      }
+
+      std::sort(angles.begin(), angles.end());
+
+      std::vector<point_2> pts;
+
+      for (double a : angles)
+      {
+         double r;
+         rand >> r;
+         pts.push_back(point_2((r + 0.5) * cos(a), (r + 0.5) * sin(a)));
+      }
+
+      cg::contour_2 polygon(pts);
+      cg::contour_2 hull = cg::melkman_hull(polygon);
+
+      std::vector<point_2> expected(pts.begin(), cg::andrew_hull(pts.begin(), pts.end()));
+      EXPECT_EQ(expected, std::vector<point_2>(hull.begin(), hull.end()));
+   }
+}
+
+TEST(melkman_hull, polylines)
+{
+   using cg::point_2;
+
+   util::uniform_random_int<int> rand(-3, 3);
+
+   for (size_t it = 0; it != 100; ++it)
+   {
+      // x monotone polyline on a grid with many collinear vertices, appended one by one
+      cg::melkman_hull_2 hull;
+      std::vector<point_2> pts;
+      int y = 0;
+
+      for (int x = 0; x != 200; ++x)
+      {
+         int dy;
+         rand >> dy;
+         y += dy / 2;
+         pts.push_back(point_2(x, y));
+         hull.add_point(pts.back());
+
+         std::vector<point_2> copy(pts);
+         std::vector<point_2> expected(copy.begin(), cg::andrew_hull(copy.begin(), copy.end()));
+         ASSERT_EQ(expected, hull.hull());
+      }
+   }
+
+   std::vector<point_2> line = boost::assign::list_of(point_2(1, 1))(point_2(1, 1))(point_2(2, 2))(point_2(0, 0))(point_2(3, 3));
+   std::vector<point_2> res;
+   cg::melkman_hull(line.begin(), line.end(), std::back_inserter(res));
+   EXPECT_EQ(std::vector<point_2>({point_2(0, 0), point_2(3, 3)}), res);
+}
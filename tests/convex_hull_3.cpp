@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+
+#include <cg/primitives/point_3.h>
+#include <cg/operations/orientation_3.h>
+#include <cg/convex_hull/convex_hull_3.h>
+#include <misc/random_utils.h>
+
+using namespace util;
+
+namespace
+{
+   std::vector<cg::point_3> uniform_points_3(size_t count)
+   {
+      uniform_random_real<double> rand(-100., 100.);
+
+      std::vector<cg::point_3> res(count);
+
+      for (cg::point_3 & p : res)
+      {
+         rand >> p.x;
+         rand >> p.y;
+         rand >> p.z;
+      }
+
+      return res;
+   }
+
+   // closed oriented 2-manifold of genus 0 with every point on the inner side of every face
+   bool is_convex_hull_3(std::vector<cg::point_3> const & pts, std::vector<cg::indexed_triangle> const & hull)
+   {
+      std::map<std::pair<size_t, size_t>, size_t> edges;
+      std::vector<bool> vertex(pts.size());
+
+      for (cg::indexed_triangle const & t : hull)
+      {
+         for (size_t i = 0; i != 3; ++i)
+         {
+            vertex[t[i]] = true;
+
+            if (edges[std::make_pair(t[i], t[(i + 1) % 3])]++ != 0)
+            {
+               return false;
+            }
+         }
+
+         for (cg::point_3 const & p : pts)
+         {
+            if (cg::orientation(pts[t[0]], pts[t[1]], pts[t[2]], p) == cg::CG_LEFT)
+            {
+               return false;
+            }
+         }
+      }
+
+      for (auto const & e : edges)
+      {
+         if (edges.count(std::make_pair(e.first.second, e.first.first)) == 0)
+         {
+            return false;
+         }
+      }
+
+      size_t v = std::count(vertex.begin(), vertex.end(), true);
+      return hull.size() == 2 * v - 4;
+   }
+}
+
+TEST(orientation_3, uniform_plane)
+{
+   uniform_random_real<double, std::mt19937> distr(-(1LL << 20), (1LL << 20));
+
+   std::vector<cg::point_3> pts = uniform_points_3(300);
+
+   for (size_t l = 0; l + 2 < pts.size(); ++l)
+   {
+      cg::point_3 a = pts[l], b = pts[l + 1], c = pts[l + 2];
+
+      for (size_t k = 0; k != 300; ++k)
+      {
+         double s = distr(), t = distr();
+         cg::point_3 d = a + s * (b - a) + t * (c - a);
+         EXPECT_EQ(cg::orientation(a, b, c, d), *cg::orientation_3_r<double>()(a, b, c, d));
+      }
+   }
+}
+
+TEST(orientation_3, simple)
+{
+   using cg::point_3;
+
+   point_3 a(0, 0, 0), b(1, 0, 0), c(0, 1, 0);
+
+   EXPECT_EQ(cg::CG_LEFT, cg::orientation(a, b, c, point_3(0.3, 0.3, 1)));
+   EXPECT_EQ(cg::CG_RIGHT, cg::orientation(a, b, c, point_3(0.3, 0.3, -1)));
+   EXPECT_EQ(cg::CG_COLLINEAR, cg::orientation(a, b, c, point_3(5, -7, 0)));
+
+   EXPECT_TRUE(cg::collinear(a, b, point_3(-3, 0, 0)));
+   EXPECT_FALSE(cg::collinear(a, b, point_3(-3, 0, 1e-30)));
+}
+
+TEST(convex_hull_3, tetrahedron)
+{
+   using cg::point_3;
+
+   std::vector<point_3> pts = {point_3(0, 0, 0), point_3(1, 0, 0), point_3(0, 1, 0), point_3(0, 0, 1), point_3(0.1, 0.1, 0.1)};
+   auto hull = cg::convex_hull_3(pts.begin(), pts.end());
+
+   EXPECT_EQ(4u, hull.size());
+   EXPECT_TRUE(is_convex_hull_3(pts, hull));
+
+   std::vector<point_3> plane = {point_3(0, 0, 0), point_3(1, 0, 0), point_3(0, 1, 0), point_3(1, 1, 0), point_3(0, 0, 0)};
+   EXPECT_TRUE(cg::convex_hull_3(plane.begin(), plane.end()).empty());
+}
+
+TEST(convex_hull_3, uniform)
+{
+   for (size_t cnt : {4, 5, 10, 100, 1000, 3000})
+   {
+      std::vector<cg::point_3> pts = uniform_points_3(cnt);
+
+      for (uint64_t seed = 0; seed != 3; ++seed)
+      {
+         EXPECT_TRUE(is_convex_hull_3(pts, cg::convex_hull_3(pts.begin(), pts.end(), seed)));
+      }
+   }
+}
+
+TEST(convex_hull_3, degenerate)
+{
+   using cg::point_3;
+
+   // cube grid: coplanar faces, collinear edges and duplicates
+   std::vector<point_3> pts;
+
+   for (int i = 0; i != 6; ++i)
+   {
+      for (int j = 0; j != 6; ++j)
+      {
+         for (int k = 0; k != 6; ++k)
+         {
+            pts.push_back(point_3(i, j, k));
+            pts.push_back(point_3(i, j, k));
+         }
+      }
+   }
+
+   for (uint64_t seed = 0; seed != 10; ++seed)
+   {
+      auto hull = cg::convex_hull_3(pts.begin(), pts.end(), seed);
+      EXPECT_TRUE(is_convex_hull_3(pts, hull));
+
+      // vertices are on the boundary of the cube, all of its corners are vertices
+      std::set<size_t> corners;
+
+      for (cg::indexed_triangle const & t : hull)
+      {
+         for (size_t v : t)
+         {
+            point_3 const & p = pts[v];
+            EXPECT_TRUE(p.x == 0 || p.x == 5 || p.y == 0 || p.y == 5 || p.z == 0 || p.z == 5);
+
+            if ((p.x == 0 || p.x == 5) && (p.y == 0 || p.y == 5) && (p.z == 0 || p.z == 5))
+            {
+               corners.insert(v / 2);
+            }
+         }
+      }
+
+      EXPECT_EQ(8u, corners.size());
+   }
+
+   // points on a sphere of integer radius
+   std::vector<point_3> sphere;
+
+   for (int i = -10; i <= 10; ++i)
+   {
+      for (int j = -10; j <= 10; ++j)
+      {
+         for (int k = -10; k <= 10; ++k)
+         {
+            if (i * i + j * j + k * k == 81)
+            {
+               sphere.push_back(point_3(i, j, k));
+            }
+         }
+      }
+   }
+
+   EXPECT_TRUE(is_convex_hull_3(sphere, cg::convex_hull_3(sphere.begin(), sphere.end())));
+}
+
+TEST(convex_hull_3, sphere)
+{
+   // every point is a vertex, many faces are removed by every insertion
+   std::vector<cg::point_3> pts = uniform_points_3(3000);
+
+   for (cg::point_3 & p : pts)
+   {
+      double r = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+      p = cg::point_3(p.x / r, p.y / r, p.z / r);
+   }
+
+   for (uint64_t seed = 0; seed != 2; ++seed)
+   {
+      EXPECT_TRUE(is_convex_hull_3(pts, cg::convex_hull_3(pts.begin(), pts.end(), seed)));
+   }
+}
+
+TEST(convex_hull_3, large)
+{
+   std::vector<cg::point_3> pts = uniform_points_3(100000);
+   EXPECT_TRUE(is_convex_hull_3(pts, cg::convex_hull_3(pts.begin(), pts.end())));
+}
+
+TEST(convex_hull_3, coplanar_extremes)
+{
+   // the points extreme in the directions of the filter are all on the plane z = x + 2y,
+   // the apex above it is not extreme in any of them
+   std::vector<cg::point_3> pts;
+
+   for (int x = 0; x <= 10; ++x)
+   {
+      for (int y = 0; y <= 10; ++y)
+      {
+         pts.push_back(cg::point_3(x, y, x + 2 * y));
+      }
+   }
+
+   pts.push_back(cg::point_3(5, 5, 15.5));
+
+   std::vector<cg::indexed_triangle> hull = cg::convex_hull_3(pts.begin(), pts.end());
+   EXPECT_TRUE(is_convex_hull_3(pts, hull));
+
+   // faces at the apex
+   size_t apex = 0;
+
+   for (cg::indexed_triangle const & t : hull)
+   {
+      apex += std::count(t.begin(), t.end(), pts.size() - 1);
+   }
+
+   EXPECT_NE(0u, apex);
+}
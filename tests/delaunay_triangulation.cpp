@@ -5,9 +5,13 @@
 #include "cg/primitives/point.h"
 #include "cg/primitives/triangle.h"
 #include "cg/triangulation/delaunay_triangulation.h"
+#include "cg/triangulation/streaming_delaunay.h"
 #include "cg/operations/contains/circumcircle_point.h"
 #include <misc/random_utils.h>
 
+#include <random>
+#include <tuple>
+
 #include "random_utils.h"
 
 using namespace util;
@@ -119,3 +123,150 @@ TEST(delaunay_triangulation, uniform_points_on_vertical_line)
    auto triangulation = cg::delaunay_triangulation(pts.begin(), pts.end());
    EXPECT_TRUE(check_delaunay(pts, triangulation));
 }
+
+TEST(delaunay_triangulation, seed_and_order_independent)
+{
+   std::vector<cg::point_2> pts = uniform_points(2000);
+   std::vector<cg::point_2> shuffled(pts);
+   std::reverse(shuffled.begin(), shuffled.end());
+
+   cg::triangulatable_points_set_2 a(pts.begin(), pts.end(), 42);
+   cg::triangulatable_points_set_2 b(shuffled.begin(), shuffled.end(), 42);
+   cg::triangulatable_points_set_2 c(pts.begin(), pts.end(), 7);
+
+   EXPECT_EQ(a.seed(), 42);
+   EXPECT_EQ(a.size(), b.size());
+
+   auto normalize = [] (std::vector<triangle_2> const & tr)
+   {
+      std::vector< std::tuple<point_2, point_2, point_2> > res;
+
+      for (triangle_2 t : tr)
+      {
+         std::sort(&t[0], &t[0] + 3);
+         res.push_back(std::make_tuple(t[0], t[1], t[2]));
+      }
+
+      std::sort(res.begin(), res.end());
+      return res;
+   };
+
+   EXPECT_EQ(normalize(a.get_triangulation()), normalize(b.get_triangulation()));
+   EXPECT_EQ(normalize(a.get_triangulation()), normalize(c.get_triangulation()));
+}
+
+TEST(delaunay_triangulation, hierarchy_levels)
+{
+   std::vector<cg::point_2> pts = uniform_points(3000);
+
+   for (uint64_t seed : {0, 42})
+   {
+      cg::triangulatable_points_set_2 a(pts.begin(), pts.end(), seed);
+
+      for (size_t order = 0; order != 3; ++order)
+      {
+         std::vector<cg::point_2> shuffled(pts);
+         std::mt19937 random(order);
+         std::shuffle(shuffled.begin(), shuffled.end(), random);
+
+         cg::triangulatable_points_set_2 b(shuffled.begin(), shuffled.end(), seed);
+         ASSERT_EQ(a.levels_count(), b.levels_count());
+
+         for (size_t level = 0; level != a.levels_count(); ++level)
+         {
+            std::vector<cg::point_2> x = a.level_points(level), y = b.level_points(level);
+            std::sort(x.begin(), x.end());
+            std::sort(y.begin(), y.end());
+            EXPECT_EQ(x, y) << "level " << level;
+         }
+      }
+   }
+}
+
+TEST(delaunay_triangulation, stats)
+{
+   std::vector<cg::point_2> pts = uniform_points(2000);
+   cg::triangulatable_points_set_2 a(pts.begin(), pts.end(), 42);
+   std::reverse(pts.begin(), pts.end());
+   cg::triangulatable_points_set_2 b(pts.begin(), pts.end(), 42);
+
+   cg::triangulation_stats s = a.stats();
+   ASSERT_FALSE(s.levels.empty());
+   EXPECT_EQ(s.levels.front().vertices, a.size());
+   EXPECT_EQ(s.levels.front().faces, 2 * a.size() - 2);
+   EXPECT_EQ(s.levels.front().faces - s.infinite_faces, a.get_triangulation().size());
+   EXPECT_GT(s.infinite_faces, 2);
+   EXPECT_GT(s.bytes, s.levels.front().faces * sizeof(void *) * 6);
+   EXPECT_GT(s.walk_length, 0);
+   EXPECT_GT(s.flips, 0);
+
+   cg::triangulation_stats t = b.stats();
+   ASSERT_EQ(s.levels.size(), t.levels.size());
+
+   for (size_t i = 0; i != s.levels.size(); ++i)
+   {
+      EXPECT_EQ(s.levels[i].vertices, t.levels[i].vertices);
+      EXPECT_EQ(s.levels[i].faces, t.levels[i].faces);
+      EXPECT_EQ(s.levels[i].infinite_faces, t.levels[i].infinite_faces);
+   }
+}
+
+TEST(streaming_delaunay, uniform_points)
+{
+   std::vector<cg::point_2> pts = uniform_points(3000);
+   const size_t CELLS = 6;
+
+   std::vector<triangle_2> streamed;
+   auto out = std::back_inserter(streamed);
+   cg::rectangle_2 bounds(cg::range(-100, 100), cg::range(-100, 100));
+   cg::streaming_delaunay_2t<double, decltype(out)> triangulator(bounds, CELLS, CELLS, out);
+
+   std::sort(pts.begin(), pts.end(), [&triangulator] (point_2 const & a, point_2 const & b)
+   {
+      return triangulator.cell(a) < triangulator.cell(b);
+   });
+
+   size_t max_active = 0;
+
+   for (auto p = pts.begin(); p != pts.end(); )
+   {
+      auto cell = triangulator.cell(*p);
+      auto q = std::find_if(p, pts.end(), [&triangulator, &cell] (point_2 const & a)
+      {
+         return triangulator.cell(a) != cell;
+      });
+
+      triangulator.insert(p, q);
+      triangulator.finalize_cell(cell.first, cell.second);
+      max_active = std::max(max_active, triangulator.active_faces());
+      p = q;
+   }
+
+   EXPECT_FALSE(streamed.empty());
+   triangulator.flush();
+   EXPECT_EQ(triangulator.active_faces(), 0);
+   // only the front is kept: fewer faces than in one row of cells of the result
+   EXPECT_LT(max_active, streamed.size() / CELLS);
+
+   auto normalize = [] (triangle_2 t)
+   {
+      std::sort(&t[0], &t[0] + 3);
+      return std::make_tuple(t[0], t[1], t[2]);
+   };
+
+   std::vector< std::tuple<point_2, point_2, point_2> > expected, actual;
+
+   for (auto const & t : cg::delaunay_triangulation(pts.begin(), pts.end()))
+   {
+      expected.push_back(normalize(t));
+   }
+
+   for (auto const & t : streamed)
+   {
+      actual.push_back(normalize(t));
+   }
+
+   std::sort(expected.begin(), expected.end());
+   std::sort(actual.begin(), actual.end());
+   EXPECT_EQ(expected, actual);
+}
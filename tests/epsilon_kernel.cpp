@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <cg/operations/epsilon_kernel.h>
+#include <cg/operations/rotating_calipers.h>
+
+#include "random_utils.h"
+
+namespace
+{
+   double extent(std::vector<cg::point_2> const & pts, cg::vector_2 const & u)
+   {
+      double lo = u * (pts[0] - cg::point_2()), hi = lo;
+
+      for (cg::point_2 const & p : pts)
+      {
+         lo = std::min(lo, u * (p - cg::point_2()));
+         hi = std::max(hi, u * (p - cg::point_2()));
+      }
+
+      return hi - lo;
+   }
+
+   double diameter(std::vector<cg::point_2> pts)
+   {
+      pts.erase(cg::andrew_hull(pts.begin(), pts.end()), pts.end());
+      std::pair<size_t, size_t> d = cg::hull_diameter(pts.begin(), pts.end());
+      return std::sqrt((pts[d.second] - pts[d.first]) * (pts[d.second] - pts[d.first]));
+   }
+}
+
+TEST(epsilon_kernel, bounds)
+{
+   using cg::point_2;
+
+   for (double eps : {0.1, 0.01, 0.001})
+   {
+      std::vector<point_2> pts = uniform_points(100000);
+
+      // a skinny set as well
+      std::vector<point_2> skinny(pts);
+
+      for (point_2 & p : skinny)
+      {
+         p = point_2(p.x + p.y, p.x + p.y + 0.01 * p.y);
+      }
+
+      for (std::vector<point_2> const * set : {&pts, &skinny})
+      {
+         cg::epsilon_kernel_2 kernel(eps);
+         kernel.add_points(set->begin(), set->end());
+
+         EXPECT_EQ(set->size(), kernel.count());
+         EXPECT_LE(kernel.hull().size(), kernel.directions());
+         EXPECT_LE(kernel.directions(), size_t(cg::pi / std::sqrt(2 * eps)) + 2);
+
+         double d = diameter(*set);
+         EXPECT_LE(kernel.diameter(), d * (1 + 1e-12));
+         EXPECT_GE(kernel.diameter(), d * (1 - eps));
+
+         double theta = cg::pi / kernel.directions();
+
+         for (size_t i = 0; i != 100; ++i)
+         {
+            cg::vector_2 u(std::cos(0.1 * i), std::sin(0.1 * i));
+            double e = extent(*set, u);
+
+            EXPECT_LE(kernel.extent(u), e * (1 + 1e-12));
+            EXPECT_GE(kernel.extent(u), e - 2 * d * std::sin(theta));
+         }
+      }
+   }
+}
+
+TEST(epsilon_kernel, exact_directions)
+{
+   using cg::point_2;
+
+   // an odd number of directions would miss the minimum along (1, 0)
+   std::vector<point_2> small = {point_2(-1, 0), point_2(-0.9, 0.3), point_2(-0.9, -0.3), point_2(1, 0)};
+   cg::epsilon_kernel_2 kernel(0.25);
+   kernel.add_points(small.begin(), small.end());
+   EXPECT_EQ(0u, kernel.directions() % 2);
+   EXPECT_DOUBLE_EQ(2, kernel.extent(cg::vector_2(1, 0)));
+
+   std::vector<point_2> pts = uniform_points(10000);
+
+   for (double eps : {0.25, 0.1, 0.01, 0.001})
+   {
+      cg::epsilon_kernel_2 kernel(eps);
+      kernel.add_points(pts.begin(), pts.end());
+
+      size_t k = kernel.directions();
+      EXPECT_EQ(0u, k % 2);
+
+      for (size_t i = 0; i != k; ++i)
+      {
+         double a = 2 * cg::pi * i / k;
+         cg::vector_2 u(std::cos(a), std::sin(a));
+         EXPECT_NEAR(extent(pts, u), kernel.extent(u), 1e-9);
+      }
+   }
+}
+
+TEST(epsilon_kernel, merge)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = uniform_points(10000);
+
+   cg::epsilon_kernel_2 whole(0.01), left(0.01), right(0.01);
+   whole.add_points(pts.begin(), pts.end());
+   left.add_points(pts.begin(), pts.begin() + 5000);
+   right.add_points(pts.begin() + 5000, pts.end());
+   left.merge(right);
+
+   EXPECT_EQ(whole.count(), left.count());
+   EXPECT_EQ(whole.hull(), left.hull());
+
+   // rotating calipers on the kernel
+   std::vector<point_2> h = whole.hull();
+   cg::calipers_result res = cg::rotating_calipers(h.begin(), h.end());
+   EXPECT_DOUBLE_EQ(whole.diameter(), std::sqrt((h[res.diameter.second] - h[res.diameter.first]) * (h[res.diameter.second] - h[res.diameter.first])));
+
+   whole.clear();
+   EXPECT_TRUE(whole.empty());
+   EXPECT_TRUE(whole.hull().empty());
+   EXPECT_EQ(0, whole.diameter());
+}
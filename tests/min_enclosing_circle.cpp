@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <boost/assign/list_of.hpp>
+
+#include <cmath>
+#include <iterator>
+
+#include <cg/operations/min_enclosing_circle.h>
+
+#include "random_utils.h"
+
+namespace
+{
+   bool covers(cg::circle_2 const & c, std::vector<cg::point_2> const & pts)
+   {
+      for (cg::point_2 const & p : pts)
+      {
+         cg::vector_2 v = p - c.center;
+
+         if (std::sqrt(v * v) > c.radius * (1 + 1e-12) + 1e-12)
+         {
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+   // smallest of the circles on two and three of the points that covers all of them
+   double brute_radius(std::vector<cg::point_2> const & pts)
+   {
+      double res = std::numeric_limits<double>::infinity();
+
+      auto consider = [&] (cg::point_2 const & center)
+      {
+         double r = 0;
+
+         for (cg::point_2 const & p : pts)
+         {
+            r = std::max(r, std::sqrt((p - center) * (p - center)));
+         }
+
+         res = std::min(res, r);
+      };
+
+      for (size_t i = 0; i != pts.size(); ++i)
+      {
+         for (size_t j = i + 1; j != pts.size(); ++j)
+         {
+            consider(cg::point_2((pts[i].x + pts[j].x) / 2, (pts[i].y + pts[j].y) / 2));
+
+            for (size_t k = j + 1; k != pts.size(); ++k)
+            {
+               cg::vector_2 b = pts[j] - pts[i], c = pts[k] - pts[i];
+               double d = 2 * (b ^ c);
+
+               if (d != 0)
+               {
+                  consider(cg::point_2(pts[i].x + (c.y * (b * b) - b.y * (c * c)) / d,
+                                       pts[i].y + (b.x * (c * c) - c.x * (b * b)) / d));
+               }
+            }
+         }
+      }
+
+      return res;
+   }
+}
+
+TEST(min_enclosing_circle, simple)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = boost::assign::list_of(point_2(0, 0))
+                                                    (point_2(2, 0))
+                                                    (point_2(1, 0.5))
+                                                    (point_2(1, -0.5));
+
+   cg::circle_2 c = cg::min_enclosing_circle(pts.begin(), pts.end());
+   EXPECT_EQ(point_2(1, 0), c.center);
+   EXPECT_DOUBLE_EQ(1, c.radius);
+
+   // equilateral, the three points are on the boundary
+   pts = boost::assign::list_of(point_2(0, 0))(point_2(2, 0))(point_2(1, std::sqrt(3.)));
+   c = cg::min_enclosing_circle(pts.begin(), pts.end());
+   EXPECT_NEAR(2 / std::sqrt(3.), c.radius, 1e-12);
+
+   pts = boost::assign::list_of(point_2(3, 4));
+   c = cg::min_enclosing_circle(pts.begin(), pts.end());
+   EXPECT_EQ(point_2(3, 4), c.center);
+   EXPECT_EQ(0, c.radius);
+
+   EXPECT_EQ(0, cg::min_enclosing_circle(pts.begin(), pts.begin()).radius);
+}
+
+TEST(min_enclosing_circle, uniform)
+{
+   for (size_t count : {2, 3, 5, 10, 40})
+   {
+      for (size_t t = 0; t != 20; ++t)
+      {
+         std::vector<cg::point_2> pts = uniform_points(count);
+         cg::circle_2 c = cg::min_enclosing_circle(pts.begin(), pts.end(), t);
+
+         EXPECT_TRUE(covers(c, pts));
+         EXPECT_NEAR(brute_radius(pts), c.radius, 1e-9);
+      }
+   }
+
+   std::vector<cg::point_2> pts = uniform_points(1000000);
+   EXPECT_TRUE(covers(cg::min_enclosing_circle(pts.begin(), pts.end()), pts));
+}
+
+TEST(min_enclosing_circle, degenerate)
+{
+   using cg::point_2;
+
+   // cocircular integer points, duplicates and collinear points
+   std::vector<point_2> pts;
+
+   for (int x = -5; x <= 5; ++x)
+   {
+      for (int y = -5; y <= 5; ++y)
+      {
+         if (x * x + y * y == 25)
+         {
+            pts.push_back(point_2(x, y));
+            pts.push_back(point_2(x, y));
+         }
+      }
+   }
+
+   for (uint64_t seed = 0; seed != 10; ++seed)
+   {
+      cg::circle_2 c = cg::min_enclosing_circle(pts.begin(), pts.end(), seed);
+      EXPECT_NEAR(0, c.center.x, 1e-12);
+      EXPECT_NEAR(0, c.center.y, 1e-12);
+      EXPECT_NEAR(5, c.radius, 1e-12);
+   }
+
+   std::vector<point_2> line;
+
+   for (int i = 0; i != 100; ++i)
+   {
+      line.push_back(point_2(i, 2 * i));
+   }
+
+   cg::circle_2 c = cg::min_enclosing_circle(line.begin(), line.end());
+   EXPECT_EQ(point_2(49.5, 99), c.center);
+   EXPECT_TRUE(covers(c, line));
+}
+
+TEST(min_enclosing_circle, batch)
+{
+   std::vector<cg::point_2> pts = uniform_points(10000);
+   std::vector<size_t> offsets = boost::assign::list_of(0)(0)(1)(3)(10)(100)(1000)(10000);
+
+   std::vector<cg::point_2> groups(pts);
+   std::vector<cg::circle_2> circles;
+   cg::min_enclosing_circles(groups.begin(), offsets.begin(), offsets.end(), std::back_inserter(circles));
+
+   ASSERT_EQ(offsets.size() - 1, circles.size());
+
+   for (size_t k = 0; k + 1 != offsets.size(); ++k)
+   {
+      std::vector<cg::point_2> group(pts.begin() + offsets[k], pts.begin() + offsets[k + 1]);
+      cg::circle_2 c = cg::min_enclosing_circle(group.begin(), group.end());
+
+      EXPECT_TRUE(covers(circles[k], group));
+      EXPECT_NEAR(c.radius, circles[k].radius, 1e-9);
+   }
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include <boost/assign/list_of.hpp>
+
+#include <cmath>
+#include <iterator>
+#include <set>
+
+#include <cg/common/constants.h>
+#include <cg/convex_hull/andrew.h>
+#include <cg/operations/rotating_calipers.h>
+#include <cg/operations/compare_dist.h>
+
+#include "random_utils.h"
+
+namespace
+{
+   typedef std::set<std::pair<size_t, size_t> > pair_set;
+
+   // largest distance from the line of the edge i to a vertex
+   double edge_height(std::vector<cg::point_2> const & h, size_t i)
+   {
+      cg::point_2 const & a = h[i], & b = h[(i + 1) % h.size()];
+      double res = 0;
+
+      for (cg::point_2 const & p : h)
+      {
+         res = std::max(res, ((b - a) ^ (p - a)) / std::sqrt((b - a) * (b - a)));
+      }
+
+      return res;
+   }
+
+   // i and j touch a pair of parallel supporting lines: the cone of the outer normals at
+   // i meets the opposite of the cone at j
+   pair_set brute_antipodal_pairs(std::vector<cg::point_2> const & h)
+   {
+      size_t n = h.size();
+
+      auto normal = [&] (size_t k)
+      {
+         cg::vector_2 e = h[(k + 1) % n] - h[k];
+         return std::atan2(-e.x, e.y);
+      };
+
+      // angle ccw from the direction a to b in [0, 2pi)
+      auto turn = [] (double a, double b)
+      {
+         double res = std::fmod(b - a, 2 * cg::pi);
+         return res < 0 ? res + 2 * cg::pi : res;
+      };
+
+      auto within = [&] (double a, double from, double to)
+      {
+         return turn(from, a) <= turn(from, to) + 1e-12;
+      };
+
+      pair_set res;
+
+      for (size_t i = 0; i != n; ++i)
+      {
+         for (size_t j = i + 1; j != n; ++j)
+         {
+            double a0 = normal((i + n - 1) % n), a1 = normal(i);
+            double b0 = normal((j + n - 1) % n) + cg::pi, b1 = normal(j) + cg::pi;
+
+            if (within(a0, b0, b1) || within(b0, a0, a1))
+            {
+               res.insert(std::make_pair(i, j));
+            }
+         }
+      }
+
+      return res;
+   }
+}
+
+TEST(rotating_calipers, square)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = boost::assign::list_of(point_2(0, 0))
+                                                    (point_2(2, 0))
+                                                    (point_2(2, 2))
+                                                    (point_2(0, 2));
+
+   std::vector<std::pair<size_t, size_t> > pairs;
+   cg::calipers_result res = cg::rotating_calipers(pts.begin(), pts.end(), std::back_inserter(pairs));
+
+   EXPECT_EQ(6u, pairs.size());
+   EXPECT_EQ(brute_antipodal_pairs(pts), pair_set(pairs.begin(), pairs.end()));
+   EXPECT_EQ(2, std::abs(int(res.diameter.first) - int(res.diameter.second)));
+   EXPECT_DOUBLE_EQ(2, res.width);
+   EXPECT_DOUBLE_EQ(4, res.min_area.area);
+   EXPECT_DOUBLE_EQ(8, res.min_perimeter.perimeter);
+
+   auto corners = cg::rectangle_corners(pts.begin(), pts.end(), res.min_area);
+
+   for (point_2 const & c : corners)
+   {
+      EXPECT_TRUE(std::find(pts.begin(), pts.end(), c) != pts.end());
+   }
+}
+
+TEST(rotating_calipers, integer_points)
+{
+   using cg::point_2i;
+
+   std::vector<point_2i> pts = boost::assign::list_of(point_2i(0, 0))
+                                                     (point_2i(3, 0))
+                                                     (point_2i(3, 1))
+                                                     (point_2i(0, 1));
+
+   std::vector<std::pair<size_t, size_t> > pairs;
+   cg::calipers_result res = cg::rotating_calipers(pts.begin(), pts.end(), std::back_inserter(pairs));
+
+   EXPECT_EQ(6u, pairs.size());
+   EXPECT_EQ(2, std::abs(int(res.diameter.first) - int(res.diameter.second)));
+   EXPECT_DOUBLE_EQ(1, res.width);
+   EXPECT_DOUBLE_EQ(3, res.min_area.area);
+   EXPECT_DOUBLE_EQ(8, res.min_perimeter.perimeter);
+}
+
+TEST(rotating_calipers, parallel_edges)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = boost::assign::list_of(point_2(1, 0))
+                                                    (point_2(2, 0))
+                                                    (point_2(3, 1))
+                                                    (point_2(3, 2))
+                                                    (point_2(2, 3))
+                                                    (point_2(1, 3))
+                                                    (point_2(0, 2))
+                                                    (point_2(0, 1));
+
+   std::vector<std::pair<size_t, size_t> > pairs;
+   cg::calipers_result res = cg::rotating_calipers(pts.begin(), pts.end(), std::back_inserter(pairs));
+
+   EXPECT_EQ(brute_antipodal_pairs(pts), pair_set(pairs.begin(), pairs.end()));
+   EXPECT_EQ(pairs.size(), pair_set(pairs.begin(), pairs.end()).size());
+   EXPECT_NEAR(2 * std::sqrt(2.), res.width, 1e-12);
+   EXPECT_NEAR(8, res.min_area.area, 1e-12);
+}
+
+TEST(rotating_calipers, degenerate)
+{
+   using cg::point_2;
+
+   std::vector<point_2> pts = boost::assign::list_of(point_2(0, 0))
+                                                    (point_2(3, 4));
+
+   cg::calipers_result res = cg::rotating_calipers(pts.begin(), pts.end());
+   EXPECT_EQ(std::make_pair(size_t(0), size_t(1)), res.diameter);
+   EXPECT_EQ(0, res.width);
+   EXPECT_EQ(0, res.min_area.area);
+   EXPECT_DOUBLE_EQ(10, res.min_perimeter.perimeter);
+
+   res = cg::rotating_calipers(pts.begin(), pts.begin() + 1);
+   EXPECT_EQ(std::make_pair(size_t(0), size_t(0)), res.diameter);
+}
+
+TEST(rotating_calipers, uniform)
+{
+   using cg::point_2;
+
+   for (size_t count : {3, 10, 100, 1000})
+   {
+      std::vector<point_2> h = uniform_points(count);
+      h.erase(cg::andrew_hull(h.begin(), h.end()), h.end());
+
+      std::vector<std::pair<size_t, size_t> > pairs;
+      cg::calipers_result res = cg::rotating_calipers(h.begin(), h.end(), std::back_inserter(pairs));
+
+      EXPECT_EQ(pairs.size(), pair_set(pairs.begin(), pairs.end()).size());
+      EXPECT_EQ(brute_antipodal_pairs(h), pair_set(pairs.begin(), pairs.end()));
+
+      std::pair<size_t, size_t> d = res.diameter;
+      EXPECT_EQ(d, cg::hull_diameter(h.begin(), h.end()));
+
+      for (size_t i = 0; i != h.size(); ++i)
+      {
+         for (size_t j = 0; j != h.size(); ++j)
+         {
+            EXPECT_FALSE(cg::compare_dist(h[d.first], h[d.second], h[i], h[j]));
+         }
+      }
+
+      double width = edge_height(h, 0);
+      double area = 0, perimeter = 0;
+
+      for (size_t i = 0; i != h.size(); ++i)
+      {
+         width = std::min(width, edge_height(h, i));
+      }
+
+      EXPECT_NEAR(width, res.width, 1e-9);
+
+      // the optimal rectangles have a side on an edge of the hull, checked against every edge
+      for (size_t i = 0; i != h.size(); ++i)
+      {
+         cg::point_2 const & a = h[i], & b = h[(i + 1) % h.size()];
+         double len = std::sqrt((b - a) * (b - a));
+         double lo = 0, hi = 0;
+
+         for (cg::point_2 const & p : h)
+         {
+            lo = std::min(lo, ((b - a) * (p - a)) / len);
+            hi = std::max(hi, ((b - a) * (p - a)) / len);
+         }
+
+         double w = hi - lo, t = edge_height(h, i);
+         area = i ? std::min(area, w * t) : w * t;
+         perimeter = i ? std::min(perimeter, 2 * (w + t)) : 2 * (w + t);
+      }
+
+      EXPECT_NEAR(area, res.min_area.area, 1e-6);
+      EXPECT_NEAR(perimeter, res.min_perimeter.perimeter, 1e-9);
+
+      // every vertex is inside the rectangle
+      auto corners = cg::rectangle_corners(h.begin(), h.end(), res.min_area);
+
+      for (size_t k = 0; k != 4; ++k)
+      {
+         cg::vector_2 side = corners[(k + 1) % 4] - corners[k];
+
+         for (cg::point_2 const & p : h)
+         {
+            EXPECT_GE((side ^ (p - corners[k])) / std::sqrt(side * side), -1e-9);
+         }
+      }
+   }
+}
@@ -1,7 +1,16 @@
+#include <cg/common/constants.h>
 #include <cg/operations/simplify.h>
+#include <cg/operations/parallel_simplify.h>
+#include <cg/operations/online_simplify.h>
+#include <cg/operations/simplify_contours.h>
+#include <cg/operations/visvalingam.h>
+#include <cg/operations/has_intersection/segment_segment.h>
 #include <gtest/gtest.h>
+#include <list>
 #include <vector>
 
+#include "random_utils.h"
+
 using namespace cg;
 
 TEST(simplify, test1)
@@ -65,3 +74,525 @@ TEST(simplify, test4)
    ASSERT_EQ(simple, expected);
 }
 
+TEST(simplify, bidirectional)
+{
+   std::vector<point_2> v = uniform_points(1000);
+   std::list<point_2> l(v.begin(), v.end());
+
+   std::vector<point_2> expected, simple;
+   simplify(v.begin(), v.end(), std::back_inserter(expected), 10);
+   simplify(l.begin(), l.end(), std::back_inserter(simple), 10);
+
+   EXPECT_EQ(expected, simple);
+}
+
+
+namespace
+{
+   // recursive douglas-peucker with the distances to lines
+   void line_simplify(std::vector<point_2> const & v, size_t a, size_t b, double eps, std::vector<point_2> & out)
+   {
+      if (a == b)
+      {
+         return;
+      }
+
+      double max = -1;
+      size_t far = b;
+
+      for (size_t i = a + 1; i < b; ++i)
+      {
+         vector_2 d = v[b] - v[a], w = v[i] - v[a];
+         double dist = (d * d == 0) ? w * w : (d ^ w) * (d ^ w) / (d * d);
+
+         if (dist > max)
+         {
+            max = dist;
+            far = i;
+         }
+      }
+
+      if (far != b && max > eps * eps)
+      {
+         line_simplify(v, a, far, eps, out);
+         line_simplify(v, far, b, eps, out);
+      }
+      else
+      {
+         out.push_back(v[b]);
+      }
+   }
+
+   std::vector<point_2> random_walk(size_t count)
+   {
+      util::uniform_random_real<double> rand(-1., 1.);
+      std::vector<point_2> res(1, point_2(0, 0));
+
+      while (res.size() != count)
+      {
+         res.push_back(point_2(res.back().x + rand(), res.back().y + rand()));
+      }
+
+      return res;
+   }
+}
+
+TEST(simplify, path_hull)
+{
+   for (double eps : {0., 0.5, 2., 10.})
+   {
+      for (size_t count : {1, 2, 3, 10, 1000, 10000})
+      {
+         std::vector<point_2> v = random_walk(count);
+
+         std::vector<point_2> expected(1, v[0]);
+         line_simplify(v, 0, v.size() - 1, eps, expected);
+
+         std::vector<point_2> simple;
+         simplify(v.begin(), v.end(), std::back_inserter(simple), eps, path_hull);
+
+         ASSERT_EQ(expected.size(), simple.size());
+         EXPECT_EQ(expected, simple);
+      }
+   }
+
+   // closed polyline: the end points are equal
+   std::vector<point_2> v
+   {
+      {0, 0}, {2, 0}, {2, 2}, {0, 2}, {0, 0}
+   };
+
+   std::vector<point_2> simple;
+   simplify(v.begin(), v.end(), std::back_inserter(simple), 0.1, path_hull);
+   EXPECT_EQ(v, simple);
+}
+
+TEST(simplify, path_hull_ties)
+{
+   // equally far vertices: the first one splits as in line_simplify
+   std::vector<point_2> v
+   {
+      {0, 0}, {1, 1}, {2, 1}, {3, 0}
+   };
+
+   std::vector<point_2> simple;
+   simplify(v.begin(), v.end(), std::back_inserter(simple), 0.5, path_hull);
+   EXPECT_EQ((std::vector<point_2>{{0, 0}, {1, 1}, {3, 0}}), simple);
+
+   // walks on the integer grid are full of ties, collinear and equal vertices
+   util::uniform_random_int<int> rand(-1, 1);
+
+   for (double eps : {0., 0.5, 1., 3.})
+   {
+      for (size_t k = 0; k != 100; ++k)
+      {
+         v.assign(1, point_2(0, 0));
+
+         while (v.size() != 200)
+         {
+            v.push_back(point_2(v.back().x + rand(), v.back().y + rand()));
+         }
+
+         std::vector<point_2> expected(1, v[0]);
+         line_simplify(v, 0, v.size() - 1, eps, expected);
+
+         simple.clear();
+         simplify(v.begin(), v.end(), std::back_inserter(simple), eps, path_hull);
+         ASSERT_EQ(expected, simple);
+      }
+   }
+}
+
+TEST(simplify, spiky)
+{
+   // deep splits: every vertex is kept
+   std::vector<point_2> v;
+
+   for (size_t i = 0; i != 1000000; ++i)
+   {
+      v.push_back(point_2(i, (i % 2) ? 1e-3 * i : 0));
+   }
+
+   std::vector<point_2> simple;
+   simplify(v.begin(), v.end(), std::back_inserter(simple), 0., path_hull);
+   EXPECT_EQ(v.size(), simple.size());
+
+   // quadratic without path hulls
+   v.resize(10000);
+   simple.clear();
+   simplify(v.begin(), v.end(), std::back_inserter(simple), 0.);
+   EXPECT_EQ(v.size(), simple.size());
+}
+
+TEST(simplify, polylines)
+{
+   util::uniform_random_int<int> rand(0, 50);
+
+   std::vector<point_2> points;
+   std::vector<size_t> offsets(1, 0);
+
+   for (size_t k = 0; k != 1000; ++k)
+   {
+      std::vector<point_2> v = random_walk(rand() + 1);
+      // empty polylines are allowed
+      v.resize(k % 10 ? v.size() : 0);
+      points.insert(points.end(), v.begin(), v.end());
+      offsets.push_back(points.size());
+   }
+
+   for (double eps : {0., 0.5, 2.})
+   {
+      for (size_t threads : {1, 2, 7})
+      {
+         std::vector<size_t> kept(points.size()), counts(offsets.size() - 1);
+         size_t total = simplify_polylines(points.begin(), offsets.begin(), offsets.end(), eps,
+                                           kept.begin(), counts.begin(), threads);
+         size_t expected_total = 0;
+
+         for (size_t k = 0; k + 1 != offsets.size(); ++k)
+         {
+            std::vector<point_2> expected;
+            simplify(points.begin() + offsets[k], points.begin() + offsets[k + 1], std::back_inserter(expected), eps);
+
+            std::vector<point_2> simple;
+
+            for (size_t i = 0; i != counts[k]; ++i)
+            {
+               simple.push_back(points[kept[offsets[k] + i]]);
+            }
+
+            ASSERT_EQ(expected, simple);
+            expected_total += expected.size();
+         }
+
+         EXPECT_EQ(expected_total, total);
+      }
+   }
+}
+
+TEST(simplify, online)
+{
+   for (double eps : {-1., 0.5, 2., 10.})
+   {
+      for (size_t count : {1, 2, 3, 10, 10000})
+      {
+         std::vector<point_2> v = random_walk(count);
+
+         online_simplifier_2 s(eps);
+         std::vector<size_t> kept;
+
+         for (size_t i = 0; i != v.size(); ++i)
+         {
+            if (boost::optional<point_2> p = s.add_point(v[i]))
+            {
+               // the kept vertex is the first or the previous one
+               ASSERT_TRUE(i == 0 || *p == v[i - 1]);
+               kept.push_back(i ? i - 1 : 0);
+            }
+         }
+
+         if (boost::optional<point_2> p = s.finish())
+         {
+            ASSERT_EQ(v.back(), *p);
+            kept.push_back(v.size() - 1);
+         }
+
+         ASSERT_EQ(0u, kept.front());
+         ASSERT_EQ(v.size() - 1, kept.back());
+
+         if (eps < 0)
+         {
+            EXPECT_EQ(v.size(), kept.size());
+         }
+
+         for (size_t k = 0; k + 1 < kept.size(); ++k)
+         {
+            for (size_t i = kept[k] + 1; i < kept[k + 1]; ++i)
+            {
+               vector_2 d = v[kept[k + 1]] - v[kept[k]], w = v[i] - v[kept[k]];
+               double t = std::max(0., std::min(1., (d * w) / (d * d)));
+               double rx = w.x - d.x * t, ry = w.y - d.y * t;
+
+               EXPECT_LE(std::sqrt(rx * rx + ry * ry), eps * (1 + 1e-9));
+            }
+         }
+      }
+   }
+
+   // a straight line, then backwards along it
+   online_simplifier_2 s(0.1);
+   std::vector<point_2> simple;
+
+   for (double x : {0., 1., 2., 3., 4., 2.})
+   {
+      if (boost::optional<point_2> p = s.add_point(point_2(x, 0)))
+      {
+         simple.push_back(*p);
+      }
+   }
+
+   simple.push_back(*s.finish());
+
+   std::vector<point_2> expected
+   {
+      {0, 0}, {4, 0}, {2, 0}
+   };
+   EXPECT_EQ(expected, simple);
+   EXPECT_FALSE(s.finish());
+}
+
+namespace
+{
+   // removed vertices are within eps of the segments between the kept ones
+   void check_contour(contour_2 const & c, contour_2 const & simple, double eps)
+   {
+      std::vector<size_t> kept;
+
+      for (size_t i = 0, j = 0; i != c.size() && j != simple.size(); ++i)
+      {
+         if (c[i] == simple[j])
+         {
+            kept.push_back(i);
+            ++j;
+         }
+      }
+
+      ASSERT_EQ(simple.size(), kept.size());
+
+      for (size_t k = 0; k != kept.size(); ++k)
+      {
+         size_t a = kept[k], b = kept[(k + 1) % kept.size()];
+
+         for (size_t i = (a + 1) % c.size(); i != b; i = (i + 1) % c.size())
+         {
+            EXPECT_LE(std::sqrt(detail::squared_distance_to_segment(c[a], c[b], c[i])), eps * (1 + 1e-9));
+         }
+      }
+   }
+
+   // segments of different contours or not adjacent in one contour only touch at common
+   // vertices or coincide
+   void check_crossings(std::vector<contour_2> const & cs)
+   {
+      std::vector<segment_2> segs;
+
+      for (contour_2 const & c : cs)
+      {
+         for (size_t i = 0; i != c.size(); ++i)
+         {
+            segs.push_back(segment_2(c[i], c[(i + 1) % c.size()]));
+         }
+      }
+
+      for (size_t i = 0; i != segs.size(); ++i)
+      {
+         for (size_t j = i + 1; j != segs.size(); ++j)
+         {
+            segment_2 const & a = segs[i], & b = segs[j];
+            bool common = a[0] == b[0] || a[0] == b[1] || a[1] == b[0] || a[1] == b[1];
+
+            if (!common)
+            {
+               ASSERT_FALSE(has_intersection(a, b)) << i << " " << j;
+            }
+         }
+      }
+   }
+}
+
+TEST(simplify, contours)
+{
+   util::uniform_random_real<double> rand(-0.3, 0.3);
+
+   // nested rings 0.4 apart at least
+   std::vector<contour_2> rings;
+
+   for (size_t k = 1; k != 11; ++k)
+   {
+      contour_2 c;
+
+      for (size_t i = 0; i != 300; ++i)
+      {
+         double a = 2 * cg::pi * i / 300, r = k + rand();
+         c.add_point(point_2(r * std::cos(a), r * std::sin(a)));
+      }
+
+      rings.push_back(c);
+   }
+
+   for (double eps : {0., 0.1, 1., 5.})
+   {
+      std::vector<contour_2> simple;
+      simplify_contours(rings.begin(), rings.end(), std::back_inserter(simple), eps);
+
+      ASSERT_EQ(rings.size(), simple.size());
+
+      size_t total = 0;
+
+      for (size_t k = 0; k != rings.size(); ++k)
+      {
+         check_contour(rings[k], simple[k], eps);
+         EXPECT_GE(simple[k].size(), 3u);
+         total += simple[k].size();
+      }
+
+      if (eps >= 1)
+      {
+         EXPECT_LT(total, 3000u / 3);
+      }
+
+      check_crossings(simple);
+   }
+}
+
+TEST(simplify, adjacent_contours)
+{
+   util::uniform_random_real<double> rand(-1., 1.);
+
+   // two polygons sharing a wiggly boundary from (0, 0) to (0, 100)
+   std::vector<point_2> border;
+
+   for (size_t i = 0; i <= 100; ++i)
+   {
+      border.push_back(point_2((i == 0 || i == 100) ? 0 : rand(), i));
+   }
+
+   std::vector<contour_2> cs(2);
+
+   for (point_2 const & p : border)
+   {
+      cs[0].add_point(p);
+   }
+
+   cs[0].add_point(point_2(-10, 100));
+   cs[0].add_point(point_2(-10, 0));
+
+   for (size_t i = border.size(); i != 0; --i)
+   {
+      cs[1].add_point(border[i - 1]);
+   }
+
+   cs[1].add_point(point_2(10, 0));
+   cs[1].add_point(point_2(10, 100));
+
+   std::vector<contour_2> simple;
+   simplify_contours(cs.begin(), cs.end(), std::back_inserter(simple), 2.);
+
+   check_contour(cs[0], simple[0], 2.);
+   check_contour(cs[1], simple[1], 2.);
+   check_crossings(simple);
+
+   // the boundary is simplified the same way in both
+   ASSERT_EQ(simple[0].size(), simple[1].size());
+   EXPECT_LT(simple[0].size(), border.size() / 2);
+
+   for (size_t i = 0; i + 2 != simple[0].size(); ++i)
+   {
+      EXPECT_EQ(simple[0][i], simple[1][simple[1].size() - 3 - i]);
+   }
+}
+
+namespace
+{
+   // quadratic visvalingam-whyatt, the removed indices and their areas in order. areas
+   // below the last removed one are raised to it
+   std::vector<std::pair<size_t, double> > naive_visvalingam(std::vector<point_2> const & v)
+   {
+      std::vector<size_t> alive;
+
+      for (size_t i = 0; i != v.size(); ++i)
+      {
+         alive.push_back(i);
+      }
+
+      std::vector<std::pair<size_t, double> > res;
+      double last = 0;
+
+      while (alive.size() > 2)
+      {
+         size_t best = 1;
+         double min = -1;
+
+         for (size_t k = 1; k + 1 != alive.size(); ++k)
+         {
+            double a = std::fabs((v[alive[k]] - v[alive[k - 1]]) ^ (v[alive[k + 1]] - v[alive[k - 1]])) / 2;
+            a = std::max(a, last);
+
+            if (min < 0 || a < min)
+            {
+               min = a;
+               best = k;
+            }
+         }
+
+         last = min;
+         res.push_back(std::make_pair(alive[best], last));
+         alive.erase(alive.begin() + best);
+      }
+
+      return res;
+   }
+}
+
+TEST(simplify, visvalingam)
+{
+   for (size_t count : {0, 1, 2, 3, 10, 1000})
+   {
+      std::vector<point_2> v = random_walk(std::max<size_t>(count, 1));
+      v.resize(count);
+
+      std::vector<std::pair<size_t, double> > expected = naive_visvalingam(v);
+
+      std::vector<double> areas(v.size());
+      visvalingam_areas(v.begin(), v.end(), areas.begin());
+
+      for (auto const & e : expected)
+      {
+         ASSERT_EQ(e.second, areas[e.first]);
+      }
+
+      if (count > 1)
+      {
+         EXPECT_TRUE(std::isinf(areas.front()));
+         EXPECT_TRUE(std::isinf(areas.back()));
+      }
+
+      std::vector<size_t> order;
+      visvalingam_order(v.begin(), v.end(), std::back_inserter(order));
+      ASSERT_EQ(v.size(), order.size());
+
+      for (size_t k = 0; k != expected.size(); ++k)
+      {
+         EXPECT_EQ(expected[k].first, order[order.size() - 1 - k]);
+      }
+
+      // any threshold: the vertices not removed while the areas are at most it
+      for (double threshold : {0., 0.1, 1., 10.})
+      {
+         std::vector<bool> removed(v.size(), false);
+
+         for (size_t k = 0; k != expected.size() && expected[k].second <= threshold; ++k)
+         {
+            removed[expected[k].first] = true;
+         }
+
+         std::vector<point_2> kept;
+
+         for (size_t i = 0; i != v.size(); ++i)
+         {
+            if (!removed[i])
+            {
+               kept.push_back(v[i]);
+            }
+         }
+
+         std::vector<point_2> simple;
+         visvalingam_simplify(v.begin(), v.end(), areas.begin(), std::back_inserter(simple), threshold);
+         EXPECT_EQ(kept, simple);
+
+         simple.clear();
+         visvalingam_simplify(v.begin(), v.end(), std::back_inserter(simple), threshold);
+         EXPECT_EQ(kept, simple);
+      }
+   }
+}